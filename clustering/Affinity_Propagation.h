@@ -7,17 +7,27 @@
 #include <Eigen/StdVector>
 #include <algorithm>            // 提供排序、随机打乱等功能
 #include <random>               // 用于更安全的随机数生成器
+#include <limits>
+#include "DistanceMatrix.h"     // 压缩存储的距离矩阵
 
 // 定义一个特殊值表示使用中位数作为Preference（偏好值）
 #define MEDIAN -114514
 
+/**
+ * AffinityPropagation：近邻传播聚类
+ * 成对距离以压缩上三角（可选 float）保存，但责任、可用性及其更新值仍是四个 N × N 的 double 矩阵，
+ * 内存仍为 O(N²)（约 32 N² 字节），压缩距离只省去其中的相似度矩阵，不适用于数万点规模
+ */
 class AffinityPropagation {
 private:
     double Damping;              // 阻尼系数，防止震荡，取值在[0.5, 1)之间
     double Tol;                  // 收敛阈值，当责任和可用性变化小于该值时停止迭代
     double Preference;           // 偏好值，决定聚类中心数量的先验，默认为MEDIAN
     int Maxiter;                 // 最大迭代次数
+    bool UseFloat;               // 距离矩阵是否以 float 存储
     Eigen::MatrixXd X;           // 输入数据矩阵，每一行是一个样本点
+    CondensedDistance Dists;     // 成对平方欧氏距离（压缩上三角）
+    double DiagSimilarity = 0.0; // 相似度矩阵对角线 s(k,k)（偏好值）
     Eigen::MatrixXd Responsibility;     // 责任矩阵（responsibility matrix）
     Eigen::MatrixXd Availability;       // 可用性矩阵（availability matrix）
     Eigen::MatrixXd new_Responsibility; // 本次迭代更新后的责任矩阵
@@ -37,9 +47,11 @@ public:
      * @param x 数据集（每行一个样本）
      * @param preference 偏好值，默认为MEDIAN
      * @param maxiter 最大迭代次数，默认1000
+     * @param useFloat 距离矩阵是否以 float 存储（默认为 double）
      */
-    AffinityPropagation(double damping, double tol, Eigen::MatrixXd x, double preference = MEDIAN, int maxiter = 1000)
-        : Damping(damping), Tol(tol), X(x), Preference(preference), Maxiter(maxiter) {
+    AffinityPropagation(double damping, double tol, Eigen::MatrixXd x, double preference = MEDIAN, int maxiter = 1000,
+                        bool useFloat = false)
+        : Damping(damping), Tol(tol), X(x), Preference(preference), Maxiter(maxiter), UseFloat(useFloat) {
         // 初始化责任矩阵和可用性矩阵为零矩阵
         Responsibility = Eigen::MatrixXd::Zero(X.rows(), X.rows());
         Availability = Eigen::MatrixXd::Zero(X.rows(), X.rows());
@@ -48,68 +60,56 @@ public:
     }
 
     /**
-     * 计算相似度矩阵（负欧氏距离平方）
-     * @return 相似度矩阵 S，S(i,j) 表示点j对点i的吸引力
+     * 计算成对平方欧氏距离（相似度为其相反数）
      */
-    Eigen::MatrixXd distance() {
-        Eigen::VectorXd row_norms = X.rowwise().squaredNorm(); // 每行的平方范数
-        Eigen::MatrixXd dot_products = X * X.transpose();     // 内积矩阵
-        Eigen::MatrixXd dists = (-2 * dot_products).rowwise() + row_norms.transpose(); // 距离计算
-        dists = dists.colwise() + row_norms;
-        return -dists; // 返回负距离作为相似度
+    void distance() {
+        Dists.compute(X, true, UseFloat);
     }
 
     /**
-     * 将相似度矩阵的对角线设置为非对角元素的中位数
-     * @param similarity 相似度矩阵
+     * 相似度 s(i,k)：非对角为负欧氏距离平方，对角线为偏好值
+     * @return 点k对点i的吸引力
      */
-    void setPreferenceToMedian(Eigen::MatrixXd& similarity) {
-        int n = similarity.rows();
-        Eigen::VectorXd off_diag(n * (n - 1));
-
-        // 提取所有非对角线元素
-        int idx = 0;
-        for (int i = 0; i < n; ++i) {
-            double* row_data = similarity.row(i).data();
-            for (int j = 0; j < n; ++j) {
-                if (i != j) {
-                    off_diag(idx++) = row_data[j];
-                }
-            }
-        }
-
-        // 排序找中位数
-        std::sort(off_diag.data(), off_diag.data() + off_diag.size());
-        double median = off_diag[off_diag.size() / 2];
+    double similarity(int i, int k) const {
+        return i == k ? DiagSimilarity : -Dists(i, k);
+    }
 
-        // 设置对角线为中位数
-        similarity.diagonal().setConstant(median);
+    /**
+     * 将相似度矩阵的对角线设置为非对角元素的中位数
+     * （每个点对在完整矩阵中出现两次，中位数即压缩存储中第 ⌊(M - 1) / 2⌋ 小的距离取反，M 为点对数）
+     */
+    void setPreferenceToMedian() {
+        std::size_t m = Dists.size();
+        DiagSimilarity = m > 0 ? -Dists.nthSmallest((m - 1) / 2) : 0.0;
     }
 
     /**
      * 设置偏好值到相似度矩阵的对角线上
-     * @param similarity 相似度矩阵
      */
-    void setPreference(Eigen::MatrixXd& similarity) {
-        similarity.diagonal().setConstant(Preference);
+    void setPreference() {
+        DiagSimilarity = Preference;
     }
 
     /**
      * 更新责任矩阵 R(i,k) = s(i,k) - max_{k'≠k} [s(i,k') + a(i,k')]
-     * @param similarity 相似度矩阵
      */
-    void new_res(Eigen::MatrixXd& similarity) {
-        Eigen::MatrixXd S_plus_A = similarity + Availability;
+    void new_res() {
+        int n = X.rows();
 
         #pragma omp parallel for
-        for (int i = 0; i < S_plus_A.rows(); ++i) {
-            Eigen::VectorXd row = S_plus_A.row(i);
+        for (int i = 0; i < n; ++i) {
+            // 第 i 行的相似度由压缩距离的行片段一次取出
+            Eigen::VectorXd s(n);
+            Dists.row(i, s.data());
+            s = -s;
+            s(i) = DiagSimilarity;
 
-            for (int k = 0; k < S_plus_A.cols(); ++k) {
+            Eigen::VectorXd row = s + Availability.row(i).transpose();
+            for (int k = 0; k < n; ++k) {
                 double temp = row(k);
                 row(k) = -1e9; // 屏蔽当前k'
                 double max_val = row.maxCoeff();
-                new_Responsibility(i, k) = similarity(i, k) - max_val;
+                new_Responsibility(i, k) = s(k) - max_val;
                 row(k) = temp;  
             }
         }
@@ -145,12 +145,11 @@ public:
 
     /**
      * 主循环：迭代更新责任和可用性矩阵直到收敛
-     * @param similarity 相似度矩阵
      */
-    void update(Eigen::MatrixXd similarity){
+    void update(){
         int i = 0;
         while(i < Maxiter){
-            new_res(similarity);
+            new_res();
             double r_diff = (new_Responsibility - Responsibility).array().abs().maxCoeff();
             Responsibility = Damping * Responsibility + (1 - Damping) * new_Responsibility;
 
@@ -233,16 +232,16 @@ public:
      * 启动整个 Affinity Propagation 流程
      */
     void start(){
-        Eigen::MatrixXd similarity = distance();
+        distance();
         if(Preference == MEDIAN){
-            setPreferenceToMedian(similarity);
+            setPreferenceToMedian();
         }
         else{
-            setPreference(similarity);
+            setPreference();
         }
         label_history.clear();
         center_history.clear();
-        update(similarity);
+        update();
         pick_center();
         labels = Assign_Labels();
     }
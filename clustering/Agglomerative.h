@@ -8,36 +8,38 @@
 #include <algorithm>            // 提供排序等功能
 #include <random>               // 用于随机数生成
 #include <queue>                // 使用优先队列实现最小堆
+#include "MST.h"                // 单链接的最小生成树路径
+#include "Dendrogram.h"         // 聚类树节点池
+#include "DistanceMatrix.h"     // 压缩存储的距离矩阵
+#include <memory>
+#include <limits>
+#include <cmath>
+#include <numeric>              // 提供 iota
 
 /**
- * ClusterNode：表示聚类树中的一个节点
+ * Linkage：簇间距离的定义方式
  */
-struct ClusterNode {
-    int id;                      // 节点唯一标识符（初始为数据点索引）
-    int height;                  // 树的高度，用于可视化或层次分析
-    std::vector<int> ids;        // 当前簇包含的所有原始数据点索引
-    ClusterNode* left;           // 左子节点
-    ClusterNode* right;          // 右子节点
+enum Linkage {
+    AverageLinkage,     // 平均链接：两簇所有点对距离的平均值
+    CompleteLinkage,    // 全链接：两簇点对距离的最大值
+    SingleLinkage,      // 单链接：两簇点对距离的最小值
+    WardLinkage         // Ward：合并后簇内平方误差和的增量（高度取其平方根形式）
+};
 
-    /**
-     * 构造函数
-     * @param _id 节点ID
-     * @param _height 当前高度
-     * @param _left 左子节点
-     * @param _right 右子节点
-     */
-    ClusterNode(int _id, int _height = 0, ClusterNode* _left = nullptr, ClusterNode* _right = nullptr)
-        : id(_id), height(_height), left(_left), right(_right) {
-        ids.push_back(id);       // 初始化时只包含自己
-    }
+/**
+ * AggloEngine：层次聚类的合并引擎
+ */
+enum AggloEngine {
+    PairQueueEngine,    // 优先队列保存每个簇的最近簇，以 double 原地累加簇间距离之和（只支持平均链接，不受 useFloat 影响）
+    NNChainEngine       // 最近邻链：Lance–Williams 公式原地更新距离矩阵，O(N²) 时间、O(N) 额外内存
 };
 
 /**
  * ClusterPair：用于优先队列中存储两个簇之间的距离信息
  */
 struct ClusterPair {
-    ClusterNode* node1;         // 第一个簇节点
-    ClusterNode* node2;         // 第二个簇节点
+    int node1;                  // 第一个簇节点 ID
+    int node2;                  // 第二个簇节点 ID
     double distance;            // 两簇之间的距离
 
     // 重载小于号，使priority_queue成为最小堆（按距离从小到大出队）
@@ -51,152 +53,340 @@ struct ClusterPair {
  */
 class Agglomerative {
 private:
-    std::vector<ClusterNode*> nodes; // 所有聚类节点集合
     Eigen::MatrixXd X;               // 输入数据集，每行是一个样本点
-    Eigen::MatrixXd dists;           // 样本点之间的成对欧氏距离矩阵
-    std::priority_queue<ClusterPair> PossibleClusters; // 优先队列，保存当前所有可能合并的簇对
+    CondensedDistance dists;         // 样本点之间的成对欧氏距离（压缩上三角；Ward 链接为平方距离）
+    std::priority_queue<ClusterPair> PossibleClusters; // 优先队列，保存每个簇到其最近簇的距离（可能过期，出队时校验）
     std::vector<bool> is_valid;      // 标记每个节点是否仍然有效（未被合并）
+    std::vector<double> sums;        // 优先队列引擎：簇间点对距离之和（接管 dists 的 double 缓冲，按 slot 压缩存放上三角）
+    std::vector<int> slot;           // 优先队列引擎：每个节点在 sums 中占用的行（合并后的簇沿用左子簇的行）
+    std::vector<int> sizes;          // 优先队列引擎：每个节点包含的样本数
+    std::vector<int> active;         // 优先队列引擎：当前簇的节点 ID
+    std::vector<int> activePos;      // 优先队列引擎：每个节点在 active 中的位置
+    std::vector<int> nearest;        // 优先队列引擎：每个簇最近一次找到的最近簇
+    std::vector<double> nearestDist; // 优先队列引擎：到该最近簇的平均距离
     int Numclusters;                 // 用户指定的目标聚类数量
+    Linkage Link;                    // 簇间距离的定义方式
+    AggloEngine Engine;              // 合并引擎
+    bool UseFloat;                   // 距离矩阵是否以 float 存储（优先队列引擎忽略）
+
+    static constexpr int DenseMSTLimit = 2048;  // 单链接：样本数不超过该值（或维度较高）时在距离矩阵上用 Prim
+    static constexpr int MaxTreeDim = 3;        // 单链接：不超过该维度的大数据集在 kd 树上用 Borůvka
+
+    /**
+     * Merge：一次合并（行号 a、b 分别是两个簇中的某个原始样本）
+     */
+    struct Merge {
+        int a;
+        int b;
+        double height;           // 合并高度（链接距离）
+    };
 
 public:
     std::vector<int> labels;         // 最终聚类标签数组（每个样本对应簇编号）
-    std::vector<ClusterNode*> roots; // 当前所有根节点（代表当前簇）
-    std::vector<std::vector<int>> label_history; // 每次迭代后的标签历史记录
-    std::vector<std::vector<ClusterNode*>> root_history; // 每次迭代后的根节点历史记录
-    std::vector<int> num_history;    // 每次迭代后剩余簇的数量变化记录
+    std::shared_ptr<Dendrogram> tree; // 聚类树节点池（结果持有，随结果一起释放）
+    std::vector<int> roots;          // 全部合并完成后的根节点 ID
+    std::vector<int> num_history;    // 每次迭代后剩余簇的数量变化记录（第 i 帧的标签与根节点由 tree 按需重建）
 
     /**
      * 构造函数
      * @param x 数据集（每行一个样本）
      * @param numclusters 目标聚类数
+     * @param linkage 簇间距离的定义方式（默认为平均链接）
+     * @param engine 合并引擎（默认为优先队列；非平均链接总是使用最近邻链）
+     * @param useFloat 距离矩阵是否以 float 存储（默认为 double；优先队列引擎总是 double）
      */
-    Agglomerative(Eigen::MatrixXd x, int numclusters)
-        : X(x), Numclusters(numclusters) {
+    Agglomerative(Eigen::MatrixXd x, int numclusters, Linkage linkage = AverageLinkage, AggloEngine engine = PairQueueEngine,
+                  bool useFloat = false)
+        : X(x), Numclusters(numclusters), Link(linkage), Engine(engine), UseFloat(useFloat) {
         is_valid = std::vector<bool>(x.rows(), true);
-        for (int i = 0; i < x.rows(); ++i) {
-            ClusterNode* node = new ClusterNode(i); // 初始每个点都是独立簇
-            nodes.push_back(node);
-            roots.push_back(node);
-        }
+        tree = std::make_shared<Dendrogram>(x.rows()); // 初始每个点都是独立簇
+    }
+
+    /**
+     * 是否使用优先队列引擎（只用于平均链接）
+     */
+    bool pairQueue() const {
+        return Engine == PairQueueEngine && Link == AverageLinkage;
     }
 
     /**
-     * 计算样本之间的欧氏距离矩阵
+     * 计算样本之间的欧氏距离矩阵（Ward 链接直接保存平方距离）。
+     * 优先队列引擎在这块存储上原地累加簇间距离之和，总是以 double 计算（UseFloat 对其无效）
      */
     void distance() {
-        Eigen::VectorXd row_norms = X.rowwise().squaredNorm();
-        Eigen::MatrixXd dot_products = X * X.transpose();
-        dists = (-2 * dot_products).rowwise() + row_norms.transpose();
-        dists = dists.colwise() + row_norms;
-        dists = dists.array().sqrt(); // 开平方得到欧氏距离
+        dists.compute(X, Link == WardLinkage, UseFloat && !pairQueue());
     }
 
     /**
-     * 初始化优先队列，将所有初始簇对加入队列
+     * 初始化优先队列：距离矩阵的 double 缓冲直接移交给 sums，作为簇间距离之和原地累加（单点簇即距离本身），
+     * 不另外复制；队列中每个簇只保存一项（到其最近簇的距离），共 N 项
      */
     void init_PossibleCLusters() {
-        for (int i = 0; i < dists.rows(); ++i) {
-            for (int j = i + 1; j < dists.cols(); ++j) {
-                PossibleClusters.push({nodes[i], nodes[j], dists(i, j)});
+        int n = dists.rows();
+        slot.resize(n);
+        std::iota(slot.begin(), slot.end(), 0);
+        sizes.assign(n, 1);
+        sums = dists.takeDouble();
+
+        active.resize(n);
+        std::iota(active.begin(), active.end(), 0);
+        activePos = active;
+        nearest.assign(n, -1);
+        nearestDist.assign(n, std::numeric_limits<double>::infinity());
+
+        std::vector<ClusterPair> pairs;
+        pairs.reserve(n);
+        for (int i = 0; i < n; ++i) {
+            if (findNearest(i)) pairs.push_back({i, nearest[i], nearestDist[i]});
+        }
+        PossibleClusters = std::priority_queue<ClusterPair>(std::less<ClusterPair>(), std::move(pairs));
+    }
+
+    /**
+     * 在当前簇中为簇 k 重新寻找最近簇，O(簇数)
+     * @return 是否找到（只剩 k 一个簇时为 false）
+     */
+    bool findNearest(int k) {
+        nearest[k] = -1;
+        nearestDist[k] = std::numeric_limits<double>::infinity();
+        for (int i : active) {
+            if (i == k) continue;
+            double d = update_average_linkage_distance(k, i);
+            if (d < nearestDist[k]) {
+                nearestDist[k] = d;
+                nearest[k] = i;
             }
         }
+        return nearest[k] >= 0;
+    }
+
+    /**
+     * 行 a、b（a != b）在 sums 中的位置（与 CondensedDistance 相同的上三角布局）
+     */
+    std::size_t sumIndex(int a, int b) const {
+        if (a > b) std::swap(a, b);
+        std::size_t n = X.rows();
+        return static_cast<std::size_t>(a) * (2 * n - a - 1) / 2 + (b - a - 1);
     }
 
     /**
-     * 使用平均链接法（Average Linkage）计算两个簇之间的距离
+     * 使用平均链接法（Average Linkage）计算两个簇之间的距离：点对距离之和除以点对数，O(1)
      * @param node1 簇1
      * @param node2 簇2
      * @return 两簇之间的平均距离
      */
-    double update_average_linkage_distance(ClusterNode* node1, ClusterNode* node2) {
-        int count = 0;
-        double total = 0.0;
-
-        #pragma omp parallel for reduction(+:total,count)
-        for (int i : node1->ids) {
-            for (int j : node2->ids) {
-                total += dists(i, j);
-                ++count;
-            }
-        }
-
-        return count > 0 ? total / count : std::numeric_limits<double>::infinity();
+    double update_average_linkage_distance(int node1, int node2) {
+        return sums[sumIndex(slot[node1], slot[node2])] / (static_cast<double>(sizes[node1]) * sizes[node2]);
     }
 
     /**
-     * 为每个样本分配当前聚类标签
-     * @return 标签数组
+     * 层次聚类主循环：每次取出全局最近的一对簇合并。队列中每个簇一项（到最近簇的距离），
+     * 平均链接下合并只会使簇间距离不小于合并前两者中的较小值，所以这些距离是各簇当前最近距离的下界：
+     * 出队项的最近簇已被合并时才重新寻找（O(簇数)）并放回队列，否则它就是全局最近的簇对
      */
-    std::vector<int> Assign_Labels() const {
-        std::vector<int> labels(X.rows());
+    void update() {
+        int n = X.rows();
+        int N = n;                // 当前簇数
+
+        while (!PossibleClusters.empty()) {
+            ClusterPair curr = PossibleClusters.top();
+            PossibleClusters.pop();
 
-        int label = 0;
-        for (const ClusterNode* node : nodes) {
-            if (is_valid[node->id]) {
-                for (int idx : node->ids) {
-                    if (idx < X.rows()) { // 只对原始数据点赋值
-                        labels[idx] = label;
-                    }
+            int k = curr.node1;
+            if (!is_valid[k] || curr.node2 != nearest[k] || curr.distance != nearestDist[k]) continue; // 过期项
+            if (!is_valid[nearest[k]]) {
+                if (findNearest(k)) PossibleClusters.push({k, nearest[k], nearestDist[k]});
+                continue;
+            }
+
+            // 子簇顺序：两个原始样本按下标从小到大，否则较新的节点在左
+            int node1 = k, node2 = nearest[k];
+            if ((node1 < n && node2 < n) ? node1 > node2 : node1 < node2) std::swap(node1, node2);
+
+            int new_node = merge(node1, node2, curr.distance, N);
+            slot.push_back(slot[node1]);
+            sizes.push_back(sizes[node1] + sizes[node2]);
+            nearest.push_back(-1);
+            nearestDist.push_back(std::numeric_limits<double>::infinity());
+            removeActive(node1);
+            removeActive(node2);
+
+            // 新簇到现有簇的距离之和即两个子簇的距离之和相加（每次合并 O(簇数)），同时得到新簇的最近簇
+            for (int i : active) {
+                double sum = sums[sumIndex(slot[node1], slot[i])] + sums[sumIndex(slot[node2], slot[i])];
+                sums[sumIndex(slot[new_node], slot[i])] = sum;
+                double avg_dist = update_average_linkage_distance(new_node, i);
+                if (avg_dist < nearestDist[new_node]) {
+                    nearestDist[new_node] = avg_dist;
+                    nearest[new_node] = i;
+                }
+                if (avg_dist < nearestDist[i]) { // 只会因舍入出现，仍保证队列中的距离是下界
+                    nearestDist[i] = avg_dist;
+                    nearest[i] = new_node;
+                    PossibleClusters.push({i, new_node, avg_dist});
                 }
-                label++;
             }
+
+            activePos.push_back(active.size());
+            active.push_back(new_node);
+            if (nearest[new_node] >= 0) PossibleClusters.push({new_node, nearest[new_node], nearestDist[new_node]});
         }
+    }
 
-        return labels;
+    /**
+     * 从当前簇列表中移除一个节点（与末尾交换，O(1)）
+     */
+    void removeActive(int node) {
+        int last = active.back();
+        active[activePos[node]] = last;
+        activePos[last] = activePos[node];
+        active.pop_back();
     }
 
     /**
-     * 层次聚类主循环：不断合并最近的簇直到达到目标簇数
+     * 合并两个当前簇：在节点池中生成新节点并记录一帧
+     * （节点 ID 即合并顺序，该帧的标签与根节点之后由 tree 在 O(N) 内重建，不在此复制）
+     * @param node1 簇1
+     * @param node2 簇2
+     * @param dist 合并高度（链接距离）
+     * @param N 当前簇数（合并后减一）
+     * @return 新节点 ID
      */
-    void update() {
-        int currentid = X.rows(); // 新簇的起始ID
-        int N = X.rows();         // 当前簇数
+    int merge(int node1, int node2, double dist, int& N) {
+        // 标记这两个簇为无效
+        is_valid[node1] = false;
+        is_valid[node2] = false;
 
-        while (!PossibleClusters.empty()) {
-            ClusterPair curr = PossibleClusters.top();
-            PossibleClusters.pop();
+        // 在节点池中创建新簇
+        int new_node = tree->merge(node1, node2, dist);
+        is_valid.push_back(true);
 
-            if (!is_valid[curr.node1->id] || !is_valid[curr.node2->id]) continue;
+        N -= 1;
+        num_history.push_back(N);
+        return new_node;
+    }
 
-            // 从根列表中移除这两个节点
-            roots.erase(std::remove(roots.begin(), roots.end(), curr.node1), roots.end());
-            roots.erase(std::remove(roots.begin(), roots.end(), curr.node2), roots.end());
+    /**
+     * Lance–Williams 公式：簇 i、j 合并后到簇 k 的距离
+     * （Ward 链接在平方距离上计算）
+     */
+    double lanceWilliams(double dik, double djk, double dij, int ni, int nj, int nk) const {
+        switch (Link) {
+        case SingleLinkage:
+            return std::min(dik, djk);
+        case CompleteLinkage:
+            return std::max(dik, djk);
+        case WardLinkage:
+            return ((ni + nk) * dik + (nj + nk) * djk - nk * dij) / double(ni + nj + nk);
+        case AverageLinkage:
+        default:
+            return (ni * dik + nj * djk) / double(ni + nj);
+        }
+    }
+
+    /**
+     * 最近邻链引擎：沿“当前簇的最近邻”延伸链，链尾两簇互为最近邻时立即合并，
+     * 合并后按 Lance–Williams 公式原地更新距离矩阵的一行。对上述四种（可约的）链接，
+     * 把所有合并按高度排序后依次重放，得到与逐次取全局最近簇对相同的层次树
+     */
+    void nnChain() {
+        int n = X.rows();
 
-            // 标记这两个簇为无效
-            is_valid[curr.node1->id] = false;
-            is_valid[curr.node2->id] = false;
+        std::vector<int> size(n, 1);
+        std::vector<int> active(n);        // 当前簇所在的行（合并后的簇占用其中一行）
+        std::vector<int> pos(n);           // 行在 active 中的位置
+        for (int i = 0; i < n; ++i) {
+            active[i] = i;
+            pos[i] = i;
+        }
 
-            // 创建新簇
-            ClusterNode* new_node = new ClusterNode(currentid, 0, curr.node1, curr.node2);
-            new_node->height = std::max(curr.node1->height, curr.node2->height) + 1;
-            new_node->ids = curr.node1->ids;
-            new_node->ids.insert(new_node->ids.end(), curr.node2->ids.begin(), curr.node2->ids.end());
+        std::vector<Merge> merges;
+        merges.reserve(n > 0 ? n - 1 : 0);
 
-            // 将新簇与现有簇的距离加入优先队列
-            for (size_t i = 0; i < nodes.size(); ++i) {
-                if (is_valid[i] && nodes[i] != curr.node1 && nodes[i] != curr.node2) {
-                    double avg_dist = update_average_linkage_distance(new_node, nodes[i]);
-                    PossibleClusters.push({new_node, nodes[i], avg_dist});
-                }
+        std::vector<int> chain;
+        while (active.size() > 1) {
+            if (chain.empty()) {
+                chain.push_back(active[0]);
             }
+            int a = chain.back();
+            int prev = chain.size() >= 2 ? chain[chain.size() - 2] : -1;
 
-            // 添加新簇到节点列表
-            roots.push_back(new_node);
-            nodes.push_back(new_node);
-            is_valid.push_back(true);
+            // 链尾的最近邻（与上一个链节点距离相同时优先取它，保证链终止）
+            int b = prev;
+            double best = prev >= 0 ? dists(a, prev) : std::numeric_limits<double>::infinity();
+            for (int c : active) {
+                if (c != a && dists(a, c) < best) {
+                    best = dists(a, c);
+                    b = c;
+                }
+            }
 
-            // 记录状态
-            std::vector<int> temp_label = Assign_Labels();
-            label_history.push_back(temp_label);
-            root_history.push_back(roots);
-            N -= 1;
-            num_history.push_back(N);
+            if (b != prev) {
+                chain.push_back(b);
+                continue;
+            }
 
-            if (N == Numclusters) {
-                labels = temp_label;
+            // a 与 prev 互为最近邻：合并到 prev 所在的行
+            chain.pop_back();
+            chain.pop_back();
+            merges.push_back(Merge{a, prev, Link == WardLinkage ? std::sqrt(best) : best});
+            for (int k : active) {
+                if (k == a || k == prev) continue;
+                double d = lanceWilliams(dists(a, k), dists(prev, k), best, size[a], size[prev], size[k]);
+                dists.set(prev, k, d);
             }
+            size[prev] += size[a];
+
+            // 从 active 中移除 a
+            int last = active.back();
+            active[pos[a]] = last;
+            pos[last] = pos[a];
+            active.pop_back();
+        }
+
+        replay(merges);
+    }
+
+    /**
+     * 单链接的最小生成树路径：层次树就是按边权排序的最小生成树。
+     * 小规模数据在距离矩阵上用 Prim，低维大数据集不建距离矩阵、在 kd 树上用 Borůvka
+     */
+    void singleLinkageMST() {
+        std::vector<MSTEdge> mst;
+        if (X.rows() > DenseMSTLimit && X.cols() <= MaxTreeDim) {
+            mst = boruvkaMST(KDTree<double>(X));
+        } else {
+            if (dists.rows() != X.rows()) distance();
+            mst = primDenseMST(dists);
+        }
 
-            currentid++;
+        std::vector<Merge> merges;
+        merges.reserve(mst.size());
+        for (const MSTEdge& e : mst) {
+            merges.push_back(Merge{e.u, e.v, e.weight});
+        }
+        replay(merges);
+    }
+
+    /**
+     * 按高度依次重放合并：行号即该行簇中的一个原始样本，用并查集找到其当前节点
+     * @param merges 所有合并（顺序任意，会按高度稳定排序）
+     */
+    void replay(std::vector<Merge>& merges) {
+        int n = X.rows();
+        std::stable_sort(merges.begin(), merges.end(), [](const Merge& l, const Merge& r) {
+            return l.height < r.height;
+        });
+
+        DisjointSet dsu(n);
+        std::vector<int> top(n);         // 每个并查集根当前对应的树节点
+        std::iota(top.begin(), top.end(), 0);
+        int N = n;
+        for (const Merge& m : merges) {
+            int ra = dsu.find(m.a);
+            int rb = dsu.find(m.b);
+            int new_node = merge(top[ra], top[rb], m.height, N);
+            top[dsu.unite(ra, rb)] = new_node;
         }
     }
 
@@ -204,9 +394,23 @@ public:
      * 启动整个层次聚类流程
      */
     void start() {
-        distance();             // 计算距离矩阵
-        init_PossibleCLusters(); // 初始化优先队列
-        update();               // 进行聚类
+        if (Link == SingleLinkage) {
+            singleLinkageMST(); // 单链接：排序后的最小生成树即层次树
+        } else {
+            distance();         // 计算距离矩阵
+            if (!pairQueue()) {
+                nnChain();      // 最近邻链合并
+            } else {
+                init_PossibleCLusters(); // 初始化优先队列
+                update();       // 进行聚类
+            }
+        }
+        tree->finalize();       // 展开叶序排列，节点改以区间表示成员
+
+        roots = tree->rootsAfter(tree->numMerges());
+        if (Numclusters >= 1 && Numclusters <= X.rows()) {
+            labels = tree->cutAtK(Numclusters);
+        }
     }
 
 };
@@ -0,0 +1,305 @@
+#ifndef APPROXDBSCAN_H
+#define APPROXDBSCAN_H
+
+#include <vector>
+#include <unordered_map>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <algorithm>
+#include <Eigen/Dense>
+#include "DBSCAN.h"             // Pointtype；高维时退回精确 DBSCAN
+#include "GridIndex.h"          // 单元坐标与哈希
+#include "MST.h"                // DisjointSet
+
+/**
+ * ApproxDBSCAN：ρ-近似 DBSCAN（Gan & Tao）
+ * 以边长 Eps / √d 的网格划分数据：同一单元内的点两两距离不超过 Eps，点数超过 Minpts 的单元整体为核心单元；
+ * 核心点与点类型与精确 DBSCAN 完全相同，只有“两个核心单元是否相连”用近似范围查询回答：
+ * 距离不超过 Eps 的核心点对一定相连，距离超过 Eps(1 + ρ) 的一定不相连，其间的可能相连。
+ * 近似查询把每个单元的核心点归入边长足够小的子单元，只比较子单元包围盒，代价与 N 无关
+ */
+class ApproxDBSCAN {
+private:
+    using Key = GridIndex::Key;
+
+    double Eps;                     // 邻域半径
+    int Minpts;                     // 成为核心点所需的最小邻域点数（不含自身，与 DBSCAN 一致）
+    double Rho;                     // 近似参数 ρ：允许把距离在 (Eps, Eps(1 + ρ)] 内的核心点视为相连
+    Eigen::MatrixXd X;              // 输入数据集（每行一个样本）
+
+    double side = 0.0;              // 单元边长 Eps / √d
+    double subSide = 0.0;           // 子单元边长（子单元对角线不超过 ρ·Eps / 2）
+
+    std::vector<Key> cellKeys;                  // 每个非空单元的坐标
+    std::vector<std::vector<int>> cells;        // 每个单元内的样本下标（升序）
+    std::vector<std::vector<int>> cellNeighbors;// 每个单元最小距离不超过 Eps 的单元（含自身）
+    std::vector<int> density;                   // 邻域点数（达到 Minpts 即停止计数）
+    std::vector<std::vector<Eigen::VectorXd>> subBoxes; // 每个单元内核心点所占子单元的下角
+    std::vector<int> cellCluster;               // 核心单元所属的连通分量（非核心单元为 -1）
+
+public:
+    std::vector<int> labels;               // 聚类结果标签（-1 表示噪声）
+    std::vector<Pointtype> point_features; // 点的类型信息（核心、边界、噪声）
+
+    /**
+     * 构造函数
+     * @param eps 邻域半径
+     * @param minpts 最小邻域点数
+     * @param rho 近似参数 ρ（> 0，越小越接近精确结果）
+     * @param x 数据集（每行一个样本）
+     */
+    ApproxDBSCAN(double eps, int minpts, double rho, Eigen::MatrixXd x)
+        : Eps(eps), Minpts(minpts), Rho(rho), X(x) {
+        labels = std::vector<int>(X.rows(), -1);
+        point_features = std::vector<Pointtype>(X.rows(), Noisepoint);
+        density = std::vector<int>(X.rows(), 0);
+    }
+
+    /**
+     * 把样本放入边长 Eps / √d 的网格，并求出每个单元的 Eps 邻近单元
+     */
+    void buildGrid() {
+        int n = X.rows();
+        int d = X.cols();
+        side = Eps / std::sqrt(static_cast<double>(d));
+        int depth = std::min(20, std::max(0, static_cast<int>(std::ceil(std::log2(2.0 / Rho)))));
+        subSide = side / static_cast<double>(1 << depth);
+
+        std::unordered_map<Key, int, GridIndex::KeyHash> index;
+        for (int i = 0; i < n; ++i) {
+            Key key = cellOf(X.row(i));
+            auto it = index.find(key);
+            if (it == index.end()) {
+                it = index.emplace(key, cells.size()).first;
+                cells.push_back(std::vector<int>());
+                cellKeys.push_back(key);
+            }
+            cells[it->second].push_back(i);
+        }
+
+        // 邻近单元的偏移：每维最多相差 ⌈√d⌉ 个单元，且两单元之间的最小距离不超过 Eps
+        int reach = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(d))));
+        std::vector<Key> offsets(1, Key(d, 0));
+        for (int j = 0; j < d; ++j) {
+            std::vector<Key> next;
+            for (const Key& o : offsets) {
+                for (int delta = -reach; delta <= reach; ++delta) {
+                    Key k = o;
+                    k[j] = delta;
+                    next.push_back(k);
+                }
+            }
+            offsets = next;
+        }
+        offsets.erase(std::remove_if(offsets.begin(), offsets.end(), [&](const Key& o) {
+            double gap = 0.0;
+            for (long long v : o) {
+                double g = std::max(0.0, static_cast<double>(std::abs(v) - 1)) * side;
+                gap += g * g;
+            }
+            return gap > Eps * Eps;
+        }), offsets.end());
+
+        cellNeighbors.assign(cells.size(), std::vector<int>());
+        for (size_t c = 0; c < cells.size(); ++c) {
+            Key key(d);
+            for (const Key& o : offsets) {
+                for (int j = 0; j < d; ++j) key[j] = cellKeys[c][j] + o[j];
+                auto it = index.find(key);
+                if (it != index.end()) cellNeighbors[c].push_back(it->second);
+            }
+        }
+    }
+
+    /**
+     * 确定核心点：点数超过 Minpts 的单元内全部为核心点，其余点在邻近单元中计数（达到 Minpts 即停止）
+     */
+    void classify() {
+        double eps_sq = Eps * Eps;
+        int ncells = cells.size();
+
+        #pragma omp parallel for schedule(dynamic, 16)
+        for (int c = 0; c < ncells; ++c) {
+            if (static_cast<int>(cells[c].size()) > Minpts) {
+                for (int i : cells[c]) density[i] = Minpts;
+                continue;
+            }
+            for (int i : cells[c]) {
+                int count = 0;
+                for (int nc : cellNeighbors[c]) {
+                    for (int j : cells[nc]) {
+                        if (j != i && (X.row(i) - X.row(j)).squaredNorm() <= eps_sq) count++;
+                    }
+                    if (count >= Minpts) break;
+                }
+                density[i] = count;
+            }
+        }
+
+        for (int i = 0; i < X.rows(); ++i) {
+            if (density[i] >= Minpts) point_features[i] = Corepoint;
+            else if (density[i] > 0) point_features[i] = Marginpoint;
+            else point_features[i] = Noisepoint;
+        }
+    }
+
+    /**
+     * 连接核心单元：相邻两个核心单元只要有一对子单元包围盒的最小距离不超过 Eps 即相连，
+     * 子单元对角线不超过 ρ·Eps / 2，因此被连接的核心点对距离不超过 Eps(1 + ρ)
+     */
+    void connectCells() {
+        int ncells = cells.size();
+        int d = X.cols();
+
+        // 每个单元内核心点所占的子单元（按下角去重）
+        subBoxes.assign(ncells, std::vector<Eigen::VectorXd>());
+        #pragma omp parallel for schedule(dynamic, 16)
+        for (int c = 0; c < ncells; ++c) {
+            std::vector<Key> seen;
+            for (int i : cells[c]) {
+                if (point_features[i] != Corepoint) continue;
+                Key sub(d);
+                for (int j = 0; j < d; ++j) {
+                    sub[j] = static_cast<long long>(std::floor(X(i, j) / subSide));
+                }
+                seen.push_back(sub);
+            }
+            std::sort(seen.begin(), seen.end());
+            seen.erase(std::unique(seen.begin(), seen.end()), seen.end());
+            for (const Key& sub : seen) {
+                Eigen::VectorXd lo(d);
+                for (int j = 0; j < d; ++j) lo(j) = sub[j] * subSide;
+                subBoxes[c].push_back(lo);
+            }
+        }
+
+        // 两个子单元包围盒之间的最小平方距离
+        auto boxGapSq = [&](const Eigen::VectorXd& a, const Eigen::VectorXd& b) {
+            double gap = 0.0;
+            for (int j = 0; j < d; ++j) {
+                double g = std::max(0.0, std::abs(a(j) - b(j)) - subSide);
+                gap += g * g;
+            }
+            return gap;
+        };
+
+        // 每个单元内核心子单元的包围盒，用于跳过离对方单元过远的子单元
+        std::vector<Eigen::VectorXd> boxLo(ncells), boxHi(ncells);
+        for (int c = 0; c < ncells; ++c) {
+            if (subBoxes[c].empty()) continue;
+            boxLo[c] = subBoxes[c][0];
+            boxHi[c] = subBoxes[c][0];
+            for (const Eigen::VectorXd& lo : subBoxes[c]) {
+                boxLo[c] = boxLo[c].cwiseMin(lo);
+                boxHi[c] = boxHi[c].cwiseMax(lo);
+            }
+            boxHi[c].array() += subSide;
+        }
+        auto cellGapSq = [&](const Eigen::VectorXd& a, int c) {
+            double gap = 0.0;
+            for (int j = 0; j < d; ++j) {
+                double g = std::max(0.0, std::max(boxLo[c](j) - (a(j) + subSide), a(j) - boxHi[c](j)));
+                gap += g * g;
+            }
+            return gap;
+        };
+
+        double eps_sq = Eps * Eps;
+        std::vector<std::pair<int, int>> edges;
+        #pragma omp parallel
+        {
+            std::vector<std::pair<int, int>> local;
+            #pragma omp for schedule(dynamic, 16)
+            for (int a = 0; a < ncells; ++a) {
+                if (subBoxes[a].empty()) continue;
+                for (int b : cellNeighbors[a]) {
+                    if (b <= a || subBoxes[b].empty()) continue;
+                    bool connected = false;
+                    for (size_t p = 0; p < subBoxes[a].size() && !connected; ++p) {
+                        if (cellGapSq(subBoxes[a][p], b) > eps_sq) continue;
+                        for (size_t q = 0; q < subBoxes[b].size() && !connected; ++q) {
+                            connected = boxGapSq(subBoxes[a][p], subBoxes[b][q]) <= eps_sq;
+                        }
+                    }
+                    if (connected) local.push_back(std::make_pair(a, b));
+                }
+            }
+            #pragma omp critical
+            edges.insert(edges.end(), local.begin(), local.end());
+        }
+
+        DisjointSet dsu(ncells);
+        for (const auto& e : edges) dsu.unite(e.first, e.second);
+        cellCluster.assign(ncells, -1);
+        for (int c = 0; c < ncells; ++c) {
+            if (!subBoxes[c].empty()) cellCluster[c] = dsu.find(c);
+        }
+    }
+
+    /**
+     * 生成标签：簇按最小核心点下标编号（与 DBSCAN 相同）；边界点归入 Eps 内相邻核心点中编号最小的簇
+     */
+    void assignLabels() {
+        int n = X.rows();
+        std::vector<int> pointCell(n);
+        for (size_t c = 0; c < cells.size(); ++c) {
+            for (int i : cells[c]) pointCell[i] = c;
+        }
+
+        std::vector<int> remap(cells.size(), -1);
+        int next = 0;
+        for (int i = 0; i < n; ++i) {
+            if (point_features[i] != Corepoint) continue;
+            int root = cellCluster[pointCell[i]];
+            if (remap[root] < 0) remap[root] = next++;
+            labels[i] = remap[root];
+        }
+
+        double eps_sq = Eps * Eps;
+        #pragma omp parallel for schedule(dynamic, 256)
+        for (int i = 0; i < n; ++i) {
+            if (point_features[i] != Marginpoint) continue;
+            int best = -1;
+            for (int nc : cellNeighbors[pointCell[i]]) {
+                if (cellCluster[nc] < 0) continue;
+                for (int j : cells[nc]) {
+                    if (point_features[j] == Corepoint && (best < 0 || labels[j] < best) &&
+                        (X.row(i) - X.row(j)).squaredNorm() <= eps_sq) {
+                        best = labels[j];
+                    }
+                }
+            }
+            labels[i] = best;
+        }
+    }
+
+    /**
+     * 启动 ρ-近似 DBSCAN；维度超过 GridIndex::MaxGridDim 时邻近单元过多，直接运行精确 DBSCAN
+     */
+    void start() {
+        if (X.rows() == 0) return;
+        if (X.cols() > GridIndex::MaxGridDim || Rho <= 0) {
+            DBSCAN exact(Eps, Minpts, X);
+            exact.start();
+            labels = exact.labels;
+            point_features = exact.point_features;
+            return;
+        }
+        buildGrid();
+        classify();
+        connectCells();
+        assignLabels();
+    }
+
+private:
+    Key cellOf(const Eigen::RowVectorXd& p) const {
+        Key key(p.size());
+        for (int j = 0; j < p.size(); ++j) {
+            key[j] = static_cast<long long>(std::floor(p(j) / side));
+        }
+        return key;
+    }
+};
+
+#endif // APPROXDBSCAN_H
@@ -8,6 +8,16 @@
 #include "DPMM.h"
 #include "K_Means.h"
 #include "Spectral.h"
+#include "OPTICS.h"
+#include "HDBSCAN.h"
+#include "IncrementalDBSCAN.h"
+#include "ApproxDBSCAN.h"
+#include <memory>           // unique_ptr：保存 K-Means 多次重启中的最优结果；shared_ptr：聚类树节点池
+#include <limits>
+#include <algorithm>        // 增量 K-Means：排序后按坐标匹配编辑前后的样本
+#ifdef _OPENMP
+#include <omp.h>            // K 扫描按线程数划分热启动链
+#endif
 
 // 定义支持的聚类算法类型枚举
 enum ClusterType {
@@ -17,16 +27,25 @@ enum ClusterType {
     agglomerative,      // 层次聚类（自底向上）
     dpmm,               // 狄利克雷过程混合模型（非参数贝叶斯聚类）
     affinity_propagation, // 相似性传播聚类
-    spectral            // 谱聚类
+    spectral,           // 谱聚类
+    optics,             // OPTICS 可达距离排序（可按任意 eps 提取 DBSCAN 结果）
+    hdbscan             // HDBSCAN* 层次密度聚类（无需 eps）
 };
 
 // 聚类参数结构体，用于统一配置不同聚类算法的参数
 struct ClusteringParams {
     ClusterType clustertype;    // 指定使用的聚类算法类型
     int k;                      // K-Means 和谱聚类中簇的数量
-    double eps;                 // DBSCAN 中邻域半径
-    int minpts;                 // DBSCAN 中最小点数
+    double eps;                 // DBSCAN 中邻域半径（OPTICS 中为提取半径）
+    double maxEps;              // OPTICS 生成半径（不大于 0 时取 eps）
+    int minpts;                 // DBSCAN 中最小点数（HDBSCAN* 中核心距离的近邻数）
+    int minClusterSize;         // HDBSCAN* 最小簇大小（不大于 0 时取 minpts）
+    bool lazyNeighbors;         // DBSCAN 只计数模式：先只统计密度，扩展簇时再按需查询邻居（降低内存峰值）
+    bool parallelDBSCAN;        // DBSCAN 并行引擎：并查集合并核心点，代替串行 BFS
+    double rho;                 // DBSCAN 近似参数 ρ（大于 0 时使用 ρ-近似 DBSCAN，核心点间距离在 Eps(1 + ρ) 内可能被连接）
     int nClusters;              // 层次聚类中的目标簇数量
+    Linkage linkage;            // 层次聚类的链接方式（平均 / 全 / 单 / Ward）
+    AggloEngine aggloEngine;    // 层次聚类的合并引擎（优先队列 / 最近邻链）
     double alpha;               // DPMM 中浓度参数
     double damping;             // Affinity Propagation 中阻尼系数
     double preference;          // Affinity Propagation 中偏好值
@@ -35,6 +54,14 @@ struct ClusteringParams {
     double sigma;               // 谱聚类中高斯核参数
     Norm normType;              // 谱聚类中归一化方式
     Inittype initType;          // K-Means 初始化方式
+    KMeansEngine kmeansEngine;  // K-Means 迭代引擎（Lloyd / Elkan / Hamerly / MiniBatch / KdTree / Bisecting）
+    int batchSize;              // Mini-batch K-Means 每批样本数
+    int historyStep;            // Mini-batch K-Means 每隔多少批、二分 K-Means 每隔多少次分裂记录一次历史
+    KMeansInit kmeansInit;      // K-Means 初始中心选取方式（随机 / k-means++ / k-means||）
+    int n_init;                 // K-Means 独立重启次数（保留代价最小的一次）
+    bool useFloat;              // K-Means 是否以 float 存储数据与中心（减半距离计算的内存带宽）；层次聚类（优先队列引擎除外，其簇间距离之和始终为 double）、AP、谱聚类以 float 存储距离矩阵
+    bool incremental;           // 增量模式：K-Means（仅 Hamerly 引擎）从上一次的中心与上下界热启动；DBSCAN 只增删编辑过的点
+    int kMax;                   // K-Means K 扫描上界（大于 k 时对 [k, kMax] 中每个 K 聚类并输出代价曲线）
     int n_neighbors;            // 谱聚类或其它算法中最近邻数量
 };
 
@@ -53,17 +80,46 @@ public:
 
     std::vector<Pointtype> point_features;    // 点特征（主要用于 DBSCAN 的核心/边界/噪声分类）
 
-    std::vector<double> probs;                // 概率分布（用于 DPMM）
+    std::vector<double> probs;                // 概率分布（用于 DPMM；HDBSCAN* 中为隶属强度）
 
-    std::vector<ClusterNode*> roots;          // 根节点列表（用于层次聚类构建树）
+    std::shared_ptr<const Dendrogram> tree;   // 聚类树节点池（层次聚类、HDBSCAN*；树窗口共享持有）
+
+    std::vector<int> roots;                   // 根节点 ID 列表（用于层次聚类、HDBSCAN* 构建树）
+
+    std::vector<int> sweep_ks;                // K 扫描中依次聚类的 K
+    std::vector<double> inertia_curve;        // K 扫描中每个 K 的代价（computeCost），用于肘部法选择 K
+    int sweep_elbow = -1;                     // 肘部在 sweep_ks 中的下标（未扫描时为 -1）
 
     // 历史记录字段（可用于可视化、调试、动画展示等）
     std::vector<std::vector<int>> label_history;              // 每次迭代后的标签变化
     std::vector<std::vector<std::vector<double>>> center_history; // 中心变化历史
     std::vector<std::vector<Pointtype>> point_feature_history;   // 点特征变化历史
     std::vector<std::vector<double>> prob_history;               // 概率分布变化历史
-    std::vector<std::vector<ClusterNode*>> root_history;         // 树根节点变化历史
     std::vector<int> num_history;                                // 当前簇数变化历史
+    bool tree_history = false;                                   // 标签与树根历史由 tree 的合并序列按需重建（层次聚类）
+    EventHistory<int> label_events;                              // 以变化事件记录的标签历史（DBSCAN）
+    EventHistory<Pointtype> point_feature_events;                // 以变化事件记录的点特征历史（DBSCAN）
+
+    std::unique_ptr<OPTICS> opticsModel;      // 最近一次 OPTICS 的排序结果（数据与参数不变时复用）
+
+    // 最近一次层次聚类的完整合并树（合并到只剩一个簇，与 nClusters 无关；数据与链接方式不变时只重新切分）
+    std::shared_ptr<const Dendrogram> aggloTree;
+    std::vector<int> aggloNumHistory;         // 对应的簇数变化历史
+    Eigen::MatrixXd aggloX;                   // 建树时的数据集
+    Linkage aggloLinkage = AverageLinkage;    // 建树时的链接方式
+    AggloEngine aggloEngine = PairQueueEngine;// 建树时的合并引擎
+    bool aggloFloat = false;                  // 建树时距离矩阵是否以 float 存储
+
+    std::unique_ptr<IncrementalDBSCAN> dbscanModel; // 增量 DBSCAN 的索引与簇结构（Eps、Minpts 不变时跨调用保留）
+    Eigen::MatrixXd dbscanX;                  // 增量 DBSCAN 中当前的数据集
+    std::vector<int> dbscanIds;               // dbscanX 每行在增量 DBSCAN 中的点编号
+
+    // 增量 K-Means 所需的上一次运行状态（均以 double 保存，与 Scalar / Dim 无关）
+    Eigen::MatrixXd prevX;                    // 上一次聚类时的数据集
+    Eigen::MatrixXd prevCenter;               // 上一次的聚类中心（K × D）
+    std::vector<int> prevLabels;              // 上一次的标签
+    Eigen::VectorXd prevUpper;                // 上一次每个样本到所属中心距离的上界
+    Eigen::VectorXd prevLower;                // 上一次每个样本到其它中心距离的下界
 
     /**
      * 构造函数
@@ -98,45 +154,94 @@ public:
         centers.clear();
         point_features.clear();
         probs.clear();
+        tree.reset();
         roots.clear();
+        sweep_ks.clear();
+        inertia_curve.clear();
+        sweep_elbow = -1;
 
         label_history.clear();
         center_history.clear();
         point_feature_history.clear();
         prob_history.clear();
-        root_history.clear();
         num_history.clear();
+        tree_history = false;
+        label_events = EventHistory<int>();
+        point_feature_events = EventHistory<Pointtype>();
 
         // 根据聚类类型选择具体算法并执行
         if (params.clustertype == k_means) {
-            K_Means c = K_Means(params.k, X, params.maxiter, params.tol);
-            c.start();
-            labels = c.labels;
-            centers = c.centers;
-
-            label_history = c.label_history;
-            center_history = c.center_history;
+            // 二维数据使用固定维度特化，其余维度使用动态维度
+            bool sweep = params.kMax > params.k;
+            if (X.cols() == 2) {
+                if (sweep) params.useFloat ? sweepKMeans<float, 2>() : sweepKMeans<double, 2>();
+                else params.useFloat ? runKMeans<float, 2>() : runKMeans<double, 2>();
+            } else {
+                if (sweep) params.useFloat ? sweepKMeans<float, Eigen::Dynamic>() : sweepKMeans<double, Eigen::Dynamic>();
+                else params.useFloat ? runKMeans<float, Eigen::Dynamic>() : runKMeans<double, Eigen::Dynamic>();
+            }
         }
 
-        if (params.clustertype == dbscan) {
-            DBSCAN c = DBSCAN(params.eps, params.minpts, X);
+        // 增量模式只支持精确 DBSCAN（界面会拒绝与 ρ 同时设置）；若直接调用时两者都设置，增量模式优先、ρ 被忽略
+        if (params.clustertype == dbscan && params.incremental) {
+            runIncrementalDBSCAN();
+        } else if (params.clustertype == dbscan && params.rho > 0) {
+            ApproxDBSCAN c = ApproxDBSCAN(params.eps, params.minpts, params.rho, X);
+            c.start();
+            labels = c.labels;
+            point_features = c.point_features;
+        } else if (params.clustertype == dbscan) {
+            DBSCAN c = DBSCAN(params.eps, params.minpts, X, params.lazyNeighbors, params.parallelDBSCAN);
             c.start();
             labels = c.labels;
             point_features = c.point_features;
 
-            label_history = c.label_history;
-            point_feature_history = c.point_feature_history;
+            label_events = std::move(c.label_history);
+            point_feature_events = std::move(c.point_feature_history);
         }
 
-        if (params.clustertype == agglomerative) {
-            Agglomerative c = Agglomerative(X, params.nClusters);
+        if (params.clustertype == optics) {
+            // 只有数据集、Minpts 或生成半径变化时才重新排序，否则直接按 eps 提取
+            double maxEps = params.maxEps > 0 ? params.maxEps : params.eps;
+            bool reuse = opticsModel && opticsModel->minpts() == params.minpts && opticsModel->maxEps() == maxEps &&
+                         opticsModel->data().rows() == X.rows() && opticsModel->data().cols() == X.cols() &&
+                         opticsModel->data() == X;
+            if (!reuse) {
+                opticsModel = std::make_unique<OPTICS>(maxEps, params.minpts, X);
+                opticsModel->start();
+            }
+            relabel(params.eps);
+        }
+
+        if (params.clustertype == hdbscan) {
+            HDBSCAN c = HDBSCAN(params.minpts, params.minClusterSize, X);
             c.start();
             labels = c.labels;
+            probs = c.probs;
+            tree = c.tree;
             roots = c.roots;
+        }
 
-            label_history = c.label_history;
-            root_history = c.root_history;
-            num_history = c.num_history;
+        if (params.clustertype == agglomerative) {
+            // 合并树与 nClusters 无关：只有数据集、链接方式、引擎或存储精度变化时才重新建树，否则直接切分
+            bool reuse = aggloTree && aggloLinkage == params.linkage && aggloEngine == params.aggloEngine &&
+                         aggloFloat == params.useFloat && aggloX.rows() == X.rows() && aggloX.cols() == X.cols() &&
+                         aggloX == X;
+            if (!reuse) {
+                Agglomerative c = Agglomerative(X, params.nClusters, params.linkage, params.aggloEngine, params.useFloat);
+                c.start();
+                aggloTree = c.tree;
+                aggloNumHistory = c.num_history;
+                aggloX = X;
+                aggloLinkage = params.linkage;
+                aggloEngine = params.aggloEngine;
+                aggloFloat = params.useFloat;
+            }
+            tree = aggloTree;
+            roots = aggloTree->rootsAfter(aggloTree->numMerges());
+            num_history = aggloNumHistory;
+            tree_history = true;
+            recut(params.nClusters);
         }
 
         if (params.clustertype == dpmm) {
@@ -150,7 +255,7 @@ public:
         }
 
         if (params.clustertype == affinity_propagation) {
-            AffinityPropagation c = AffinityPropagation(params.damping, params.tol, X, params.preference, params.maxiter);
+            AffinityPropagation c = AffinityPropagation(params.damping, params.tol, X, params.preference, params.maxiter, params.useFloat);
             c.start();
             labels = c.labels;
             centers = c.centers;
@@ -160,7 +265,7 @@ public:
         }
 
         if (params.clustertype == spectral) {
-            Spectral c = Spectral(params.k, X, params.normType);
+            Spectral c = Spectral(params.k, X, params.normType, params.sigma, params.useFloat);
             c.start();
             labels = c.labels;
 
@@ -168,6 +273,353 @@ public:
         }
     }
 
+    /**
+     * 增量 DBSCAN：把当前样本与上一次的样本按坐标匹配，只删除消失的点、插入新增的点，
+     * 其余点的密度与簇结构沿用；Eps、Minpts 或维度变化时重新建立
+     */
+    void runIncrementalDBSCAN() {
+        bool reuse = dbscanModel && dbscanModel->eps() == params.eps && dbscanModel->minpts() == params.minpts &&
+                     dbscanModel->dim() == X.cols();
+        if (!reuse) {
+            dbscanModel = std::make_unique<IncrementalDBSCAN>(params.eps, params.minpts, X.cols());
+            dbscanX = Eigen::MatrixXd(0, X.cols());
+            dbscanIds.clear();
+        }
+
+        std::vector<int> match = matchRows(dbscanX, X);
+        std::vector<bool> kept(dbscanX.rows(), false);
+        for (int j : match) {
+            if (j >= 0) kept[j] = true;
+        }
+        for (int j = 0; j < dbscanX.rows(); ++j) {
+            if (!kept[j]) dbscanModel->remove(dbscanIds[j]);
+        }
+
+        std::vector<int> ids(X.rows());
+        for (int i = 0; i < X.rows(); ++i) {
+            ids[i] = match[i] >= 0 ? dbscanIds[match[i]] : dbscanModel->insert(X.row(i));
+        }
+        dbscanX = X;
+        dbscanIds = ids;
+
+        dbscanModel->snapshot(dbscanIds, labels, point_features);
+    }
+
+    /**
+     * 由已有的 OPTICS 排序按新的 eps 重新提取标签与点特征（不重新聚类）
+     * @param eps 提取半径（超过生成半径时按生成半径提取）
+     * @return 是否成功（当前结果不是 OPTICS 时返回 false）
+     */
+    bool relabel(double eps) {
+        if (params.clustertype != optics || !opticsModel || opticsModel->data().rows() != X.rows()) {
+            return false;
+        }
+        params.eps = eps;
+        opticsModel->extract(eps);
+        labels = opticsModel->labels;
+        point_features = opticsModel->point_features;
+        return true;
+    }
+
+    /**
+     * 由已有的层次聚类合并树按新的簇数重新切分标签（不重新聚类），O(N)
+     * @param k 目标簇数
+     * @return 是否成功（当前结果不是层次聚类或 k 不在 [1, N] 内时返回 false）
+     */
+    bool recut(int k) {
+        if (params.clustertype != agglomerative || !aggloTree || aggloTree->numLeaves() != X.rows() ||
+            k < 1 || k > X.rows()) {
+            return false;
+        }
+        params.nClusters = k;
+        labels = aggloTree->cutAtK(k);
+        return true;
+    }
+
+    /**
+     * 历史帧数（标签以事件记录时取事件历史的帧数，层次聚类为合并次数）
+     */
+    int historySize() const {
+        if (!label_events.empty()) return label_events.size();
+        if (tree_history) return num_history.size();
+        return label_history.size();
+    }
+
+    /**
+     * 第 i 帧的标签（事件历史由最近的关键帧回放得到，层次聚类由前 i + 1 次合并在 O(N) 内重建）
+     */
+    std::vector<int> labelFrame(int i) const {
+        if (!label_events.empty()) return label_events.frame(i);
+        if (tree_history) return tree->labelsAfter(i + 1);
+        return label_history[i];
+    }
+
+    /**
+     * 树根历史的帧数
+     */
+    int rootHistorySize() const {
+        return tree_history ? num_history.size() : 0;
+    }
+
+    /**
+     * 第 i 帧的树根节点 ID（前 i + 1 次合并之后的各簇）
+     */
+    std::vector<int> rootFrame(int i) const {
+        return tree->rootsAfter(i + 1);
+    }
+
+    /**
+     * 点特征历史的帧数
+     */
+    int pointFeatureHistorySize() const {
+        return point_feature_events.empty() ? point_feature_history.size() : point_feature_events.size();
+    }
+
+    /**
+     * 第 i 帧的点特征
+     */
+    std::vector<Pointtype> pointFeatureFrame(int i) const {
+        return point_feature_events.empty() ? point_feature_history[i] : point_feature_events.frame(i);
+    }
+
+    /**
+     * 运行 K-Means：n_init 次独立初始化在线程池中并行执行，
+     * 只保留代价（inertia，computeCost）最小的一次及其历史记录
+     * @tparam Scalar 数据存储类型
+     * @tparam Dim 数据维度
+     */
+    template <typename Scalar, int Dim>
+    void runKMeans() {
+        int n_init = std::max(1, params.n_init);
+        std::unique_ptr<K_Means<Scalar, Dim>> best;
+        double best_cost = std::numeric_limits<double>::infinity();
+
+        // 增量模式下优先从上一次的结果热启动，热启动只运行一次（仅 Hamerly 引擎，其余引擎照常冷启动）
+        if (params.incremental) {
+            best = warmKMeans<Scalar, Dim>();
+            if (best) n_init = 0;
+        }
+
+        // 只有一次时不开外层并行，让 K_Means 内部的并行分配使用全部线程
+        #pragma omp parallel for schedule(dynamic) if(n_init > 1)
+        for (int r = 0; r < n_init; ++r) {
+            auto trial = std::make_unique<K_Means<Scalar, Dim>>(params.k, X, params.maxiter, params.tol, params.kmeansEngine,
+                                                   params.batchSize, params.historyStep, params.kmeansInit);
+            trial->start();
+            double cost = trial->computeCost();
+
+            // 落选的结果在离开本轮时即被释放，不会同时保留所有历史
+            #pragma omp critical
+            {
+                if (!best || cost < best_cost) {
+                    best_cost = cost;
+                    best = std::move(trial);
+                }
+            }
+        }
+
+        labels = best->labels;
+        centers = best->centers;
+
+        label_history = std::move(best->label_history);
+        center_history = std::move(best->center_history);
+
+        if (params.incremental && params.kmeansEngine == HamerlyEngine) {
+            prevX = X;
+            prevCenter = best->centerMatrix();
+            prevLabels = labels;
+            best->exportBounds(prevUpper, prevLower);
+        }
+    }
+
+    /**
+     * K 扫描：对 [k, kMax] 中的每个 K 聚类并记录代价曲线。K 区间按线程数切成若干连续段并行执行，
+     * 每段第一个 K 按所选方式初始化，其后每个 K 都从上一个 K 的结果热启动（追加 D² 抽样的新中心，仍按所选引擎迭代）。
+     * 历史记录每个 K 一帧，最终标签与中心取代价曲线肘部对应的 K
+     * @tparam Scalar 数据存储类型
+     * @tparam Dim 数据维度
+     */
+    template <typename Scalar, int Dim>
+    void sweepKMeans() {
+        int k_lo = std::max(1, params.k);
+        int k_hi = std::min<int>(params.kMax, X.rows());
+        int count = std::max(0, k_hi - k_lo + 1);
+        if (count == 0) {
+            return;
+        }
+
+        int chains = 1;
+#ifdef _OPENMP
+        chains = std::min(count, omp_get_max_threads());
+#endif
+        std::vector<std::vector<int>> sweep_labels(count);
+        std::vector<std::vector<std::vector<double>>> sweep_centers(count);
+        sweep_ks.resize(count);
+        inertia_curve.resize(count);
+
+        #pragma omp parallel for schedule(dynamic)
+        for (int c = 0; c < chains; ++c) {
+            std::random_device rd;
+            std::mt19937 gen(rd());
+            std::unique_ptr<K_Means<Scalar, Dim>> prev;
+
+            for (int j = c * count / chains; j < (c + 1) * count / chains; ++j) {
+                int k = k_lo + j;
+                auto cur = std::make_unique<K_Means<Scalar, Dim>>(k, X, params.maxiter, params.tol, params.kmeansEngine,
+                                                       params.batchSize, params.historyStep,
+                                                       prev ? RandomInit : params.kmeansInit);
+                if (prev) {
+                    cur->warmStartFrom(*prev, gen);
+                }
+                cur->start();
+
+                sweep_ks[j] = k;
+                inertia_curve[j] = cur->computeCost();
+                sweep_labels[j] = cur->labels;
+                sweep_centers[j] = cur->centers;
+                prev = std::move(cur);
+            }
+        }
+
+        int elbow = elbowIndex(sweep_ks, inertia_curve);
+        sweep_elbow = elbow;
+        labels = sweep_labels[elbow];
+        centers = sweep_centers[elbow];
+        label_history = std::move(sweep_labels);
+        center_history = std::move(sweep_centers);
+    }
+
+    /**
+     * 肘部法：把 (K, 代价) 两个方向都归一化到 [0, 1] 后，取离首尾连线最远（位于连线下方）的点
+     * @param ks 各个 K
+     * @param costs 对应的代价
+     * @return 肘部在序列中的下标
+     */
+    static int elbowIndex(const std::vector<int>& ks, const std::vector<double>& costs) {
+        int n = ks.size();
+        if (n < 3) {
+            return 0;
+        }
+        double k_span = ks.back() - ks.front();
+        double c_span = costs.front() - costs.back();
+        if (c_span <= 0) {
+            return 0;
+        }
+
+        int best = 0;
+        double best_gap = 0.0;
+        for (int i = 0; i < n; ++i) {
+            double x = (ks[i] - ks.front()) / k_span;
+            double y = (costs[i] - costs.back()) / c_span;
+            double gap = (1.0 - x) - y; // 首尾连线为 y = 1 - x
+            if (gap > best_gap) {
+                best_gap = gap;
+                best = i;
+            }
+        }
+        return best;
+    }
+
+    /**
+     * 增量 K-Means：把当前样本与上一次的样本按坐标一一匹配，未变动的样本沿用标签与上下界，
+     * 新增样本在 warmStart 中精确分配，删除的样本直接丢弃
+     * 热启动沿用的上下界只对 Hamerly 有意义，所选引擎不是 Hamerly 时不做热启动，由调用方按所选引擎冷启动
+     * @return 热启动并运行完毕的 K_Means；所选引擎不是 Hamerly、上一次状态不可用（K 或维度变化、匹配的样本不足一半）时返回空
+     */
+    template <typename Scalar, int Dim>
+    std::unique_ptr<K_Means<Scalar, Dim>> warmKMeans() {
+        if (params.kmeansEngine != HamerlyEngine) {
+            return nullptr;
+        }
+        if (prevCenter.rows() != params.k || prevX.cols() != X.cols() || X.rows() < params.k) {
+            return nullptr;
+        }
+
+        std::vector<int> match = matchRows(prevX, X);
+        int n = X.rows();
+        int kept = 0;
+        std::vector<int> warmLabels(n, -1);
+        Eigen::VectorXd upper = Eigen::VectorXd::Zero(n);
+        Eigen::VectorXd lower = Eigen::VectorXd::Zero(n);
+        for (int i = 0; i < n; ++i) {
+            int j = match[i];
+            if (j < 0) continue;
+            warmLabels[i] = prevLabels[j];
+            upper(i) = prevUpper(j);
+            lower(i) = prevLower(j);
+            kept++;
+        }
+        if (2 * kept < n) {
+            return nullptr; // 大部分点已变化（如整体缩放），热启动没有意义
+        }
+
+        auto c = std::make_unique<K_Means<Scalar, Dim>>(params.k, X, params.maxiter, params.tol, HamerlyEngine,
+                                                  params.batchSize, params.historyStep, RandomInit);
+        c->warmStart(prevCenter, warmLabels, upper, lower);
+        c->start();
+        return c;
+    }
+
+    /**
+     * 按坐标把新数据集的每一行匹配到旧数据集中完全相同的一行（重复点按出现顺序一一对应）。
+     * 交互编辑通常只改动少量点，因此先按位置剥去首尾相同的部分，只对中间段排序后归并匹配
+     * @param oldX 旧数据集
+     * @param newX 新数据集
+     * @return 新数据集每行对应的旧行下标（无对应时为 -1）
+     */
+    static std::vector<int> matchRows(const Eigen::MatrixXd& oldX, const Eigen::MatrixXd& newX) {
+        int n_old = oldX.rows();
+        int n_new = newX.rows();
+        std::vector<int> match(n_new, -1);
+
+        int head = 0;
+        while (head < n_old && head < n_new && oldX.row(head) == newX.row(head)) {
+            match[head] = head;
+            head++;
+        }
+        int tail = 0;
+        while (tail < n_old - head && tail < n_new - head &&
+               oldX.row(n_old - 1 - tail) == newX.row(n_new - 1 - tail)) {
+            match[n_new - 1 - tail] = n_old - 1 - tail;
+            tail++;
+        }
+
+        // 行的字典序比较：返回 <0、0、>0
+        auto compare = [](const Eigen::MatrixXd& A, int a, const Eigen::MatrixXd& B, int b) {
+            for (int j = 0; j < A.cols(); ++j) {
+                if (A(a, j) < B(b, j)) return -1;
+                if (A(a, j) > B(b, j)) return 1;
+            }
+            return 0;
+        };
+        auto sortedRange = [&](const Eigen::MatrixXd& M, int begin, int end) {
+            std::vector<int> idx(end - begin);
+            for (int i = begin; i < end; ++i) {
+                idx[i - begin] = i;
+            }
+            std::sort(idx.begin(), idx.end(), [&](int a, int b) {
+                int c = compare(M, a, M, b);
+                return c != 0 ? c < 0 : a < b;
+            });
+            return idx;
+        };
+
+        std::vector<int> olds = sortedRange(oldX, head, n_old - tail);
+        std::vector<int> news = sortedRange(newX, head, n_new - tail);
+        size_t p = 0, q = 0;
+        while (p < olds.size() && q < news.size()) {
+            int c = compare(oldX, olds[p], newX, news[q]);
+            if (c == 0) {
+                match[news[q++]] = olds[p++];
+            } else if (c < 0) {
+                p++;
+            } else {
+                q++;
+            }
+        }
+        return match;
+    }
+
 };
 
 #endif // CLUSTER_H
\ No newline at end of file
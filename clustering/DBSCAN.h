@@ -7,6 +7,10 @@
 #include <Eigen/StdVector>
 #include <algorithm>            // 提供排序等功能
 #include <random>               // 用于随机数生成
+#include <queue>                // 扩展簇时的 BFS 队列
+#include <atomic>               // 并行引擎的无锁并查集
+#include "GridIndex.h"          // 均匀网格空间哈希（邻域查询）
+#include "EventHistory.h"       // 以变化事件记录标签 / 点类型历史
 
 /**
  * Pointtype：用于标识点的类型
@@ -25,66 +29,231 @@ private:
     double Eps;                     // 邻域半径（epsilon）
     int Minpts;                     // 成为核心点所需的最小邻域点数
     Eigen::MatrixXd X;              // 输入数据集（每行一个样本）
+    bool Lazy;                      // 只计数模式：先只统计密度，扩展簇时再按需查询核心点的邻居
+    bool Parallel;                  // 并行引擎：并查集合并相邻核心点，代替串行 BFS
+    GridIndex Grid;                 // 以 Eps 为边长的网格索引
 
     std::vector<int> density;       // 每个点的密度（即其邻域内的点数量）
-    std::vector<std::vector<int>> neighbors; // 每个点的邻居索引列表
+    std::vector<size_t> nbOffset;   // 邻接表（CSR）：第 i 个点的邻居位于 nbIndex[nbOffset[i], nbOffset[i + 1])
+    std::vector<int> nbIndex;       // 邻接表（CSR）：所有点的邻居下标依次拼接（只计数模式下为空）
     std::vector<bool> visited;      // 标记是否已访问该点
+    std::vector<std::atomic<int>> parent; // 并查集父节点（仅并行引擎使用，始终指向更小的下标）
 
 public:
     std::vector<Pointtype> point_features; // 点的类型信息（核心、边界、噪声）
     std::vector<int> labels;               // 聚类结果标签（-1 表示噪声）
-    std::vector<std::vector<int>> label_history;          // 每次迭代后的标签历史记录
-    std::vector<std::vector<Pointtype>> point_feature_history; // 每次迭代后的点类型历史记录
+    EventHistory<int> label_history;                 // 标签历史（每帧只记录变化的点）
+    EventHistory<Pointtype> point_feature_history;   // 点类型历史（每帧只记录变化的点）
 
     /**
      * 构造函数
      * @param eps 邻域半径 epsilon
      * @param minpts 最小邻域点数
      * @param x 数据集（每行一个样本）
+     * @param lazy 是否使用只计数模式（默认为否；邻居很多时可大幅降低内存峰值）
+     * @param parallel 是否使用并行引擎（默认为否；结果与串行一致，但历史记录只保留阶段性快照）
      */
-    DBSCAN(double eps, int minpts, Eigen::MatrixXd x)
-        : Eps(eps), Minpts(minpts), X(x) {
+    DBSCAN(double eps, int minpts, Eigen::MatrixXd x, bool lazy = false, bool parallel = false)
+        : Eps(eps), Minpts(minpts), X(x), Lazy(lazy), Parallel(parallel) {
         labels = std::vector<int>(X.rows(), -1); // 初始化为 -1（未分类或噪声）
         point_features = std::vector<Pointtype>(X.rows());
         density = std::vector<int>(X.rows(), 0);
-        neighbors = std::vector<std::vector<int>>(X.rows());
         visited = std::vector<bool>(X.rows(), false);
+        label_history.reset(labels);
+        point_feature_history.reset(point_features);
+    }
+
+    /**
+     * 把 after 与 before 不同的元素作为一帧记入历史（并行阶段结束后统一记录）
+     * @param history 要写入的历史
+     * @param before 本阶段开始前的状态
+     * @param after 本阶段结束后的状态
+     */
+    template <typename T>
+    static void recordChanges(EventHistory<T>& history, const std::vector<T>& before, const std::vector<T>& after) {
+        for (size_t i = 0; i < after.size(); ++i) {
+            if (before[i] != after[i]) {
+                history.record(i, before[i], after[i]);
+            }
+        }
+        history.commit();
+    }
+
+    /**
+     * 按升序对第 i 个点的每个邻居调用 f(邻居下标)
+     * @param i 点的索引
+     * @param f 回调函数（只计数模式下邻居由网格即时查询）
+     */
+    template <typename Func>
+    void forEachNeighbor(int i, Func f) const {
+        if (Lazy) {
+            for (int j : Grid.radiusSearch(i, Eps)) {
+                f(j);
+            }
+            return;
+        }
+        for (size_t p = nbOffset[i]; p < nbOffset[i + 1]; ++p) {
+            f(nbIndex[p]);
+        }
     }
 
     /**
      * 计算每个点的邻居及其密度（基于欧氏距离）
+     * 以 Eps 为边长建立网格，每个点只与相邻单元中的点比较，不再构建 N × N 距离矩阵
      */
     void distance() {
         int n = X.rows();                   // 数据点数量
-        Eigen::VectorXd row_norms = X.rowwise().squaredNorm(); // 每个样本的平方L2范数
+        Grid = GridIndex(X, Eps);
 
-        // 计算所有点之间的平方距离：dists_sq(i,j) = ||x_i - x_j||^2
-        Eigen::MatrixXd dot_products = X * X.transpose();
-        Eigen::MatrixXd dists_sq = (-2 * dot_products).rowwise() + row_norms.transpose();
-        dists_sq = dists_sq.colwise() + row_norms;
+        // 先统计密度；非只计数模式下按密度一次性分配 CSR 空间，再逐点填入邻居（升序，与逐行扫描的顺序一致）
+        #pragma omp parallel for schedule(dynamic, 256)
+        for (int i = 0; i < n; ++i) {
+            density[i] = Grid.radiusCount(i, Eps);
+        }
+        nbOffset.assign(Lazy ? 0 : n + 1, 0);
+        nbIndex.clear();
+        if (!Lazy) {
+            for (int i = 0; i < n; ++i) {
+                nbOffset[i + 1] = nbOffset[i] + density[i];
+            }
+            nbIndex.resize(nbOffset[n]);
+        }
 
-        double eps_sq = Eps * Eps; // 使用平方避免开根号计算
+        // 填入邻居（各点写入各自的区间，可并行）
+        if (!Lazy) {
+            #pragma omp parallel for schedule(dynamic, 256)
+            for (int i = 0; i < n; ++i) {
+                std::vector<int> nb = Grid.radiusSearch(i, Eps);
+                std::copy(nb.begin(), nb.end(), nbIndex.begin() + nbOffset[i]);
+            }
+        }
 
-        // 构建邻居列表和密度
+        // 根据密度确定点类型
+        if (Parallel) {
+            std::vector<Pointtype> before = point_features;
+            #pragma omp parallel for schedule(static)
+            for (int i = 0; i < n; ++i) {
+                point_features[i] = classify(i);
+            }
+            recordChanges(point_feature_history, before, point_features); // 并行分类后只记录一帧
+            return;
+        }
         for (int i = 0; i < n; ++i) {
-            for (int j = 0; j < n; ++j) {
-                if (i != j && dists_sq(i, j) <= eps_sq) {
-                    ++density[i];             // 邻居数量增加
-                    neighbors[i].push_back(j); // 添加邻居索引
-                }
+            Pointtype type = classify(i);
+            point_feature_history.record(i, point_features[i], type); // 每个点一帧
+            point_feature_history.commit();
+            point_features[i] = type;
+        }
+    }
+
+    /**
+     * 根据密度确定第 i 个点的类型
+     */
+    Pointtype classify(int i) const {
+        if (density[i] >= Minpts) {
+            return Corepoint;
+        } else if (density[i] > 0) {
+            return Marginpoint;
+        }
+        return Noisepoint;
+    }
+
+    /**
+     * 无锁并查集查找（路径减半）：父节点只会被改为更小的下标，因此不会成环
+     * @param x 点的索引
+     * @return x 所在集合的根（集合内最小的下标）
+     */
+    int findRoot(int x) {
+        while (true) {
+            int p = parent[x].load(std::memory_order_relaxed);
+            if (p == x) {
+                return x;
+            }
+            int gp = parent[p].load(std::memory_order_relaxed);
+            if (gp != p) {
+                parent[x].compare_exchange_weak(p, gp, std::memory_order_relaxed);
             }
+            x = gp;
+        }
+    }
 
-            // 根据密度确定点类型
-            if (density[i] >= Minpts) {
-                point_features[i] = Corepoint;
-            } else if (density[i] > 0) {
-                point_features[i] = Marginpoint;
-            } else {
-                point_features[i] = Noisepoint;
+    /**
+     * 无锁合并：总是把较大的根挂到较小的根下，CAS 失败说明根已变化，重新查找后重试
+     */
+    void unite(int a, int b) {
+        while (true) {
+            a = findRoot(a);
+            b = findRoot(b);
+            if (a == b) {
+                return;
+            }
+            if (a < b) {
+                std::swap(a, b);
+            }
+            int expected = a;
+            if (parent[a].compare_exchange_strong(expected, b, std::memory_order_relaxed)) {
+                return;
             }
+        }
+    }
 
-            point_feature_history.push_back(point_features); // 保存状态快照
+    /**
+     * 并行引擎：并行合并相邻核心点，按根的下标顺序给簇编号，最后并行挂接边界点
+     * 簇编号与串行 BFS 完全一致：每个簇以其最小的核心点下标排序，边界点归入相邻核心点中编号最小的簇
+     */
+    void unionClusters() {
+        int n = X.rows();
+        parent = std::vector<std::atomic<int>>(n);
+        for (int i = 0; i < n; ++i) {
+            parent[i].store(i, std::memory_order_relaxed);
         }
+
+        // 第一步：合并相邻的核心点
+        #pragma omp parallel for schedule(dynamic, 256)
+        for (int i = 0; i < n; ++i) {
+            if (point_features[i] != Corepoint) continue;
+            forEachNeighbor(i, [&](int j) {
+                if (j > i && point_features[j] == Corepoint) {
+                    unite(i, j);
+                }
+            });
+        }
+
+        // 第二步：规范化簇编号（根即连通分量内最小的核心点下标）
+        std::vector<int> before = labels;
+        int label = 0;
+        for (int i = 0; i < n; ++i) {
+            if (point_features[i] == Corepoint && findRoot(i) == i) {
+                labels[i] = label++;
+            }
+        }
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < n; ++i) {
+            if (point_features[i] != Corepoint) continue;
+            int root = findRoot(i);
+            if (root != i) {
+                labels[i] = labels[root]; // 根的编号已在上面串行写好，这里只读
+            }
+        }
+        recordChanges(label_history, before, labels);
+        point_feature_history.commit();
+
+        before = labels;
+
+        // 第三步：边界点归入相邻核心点中编号最小的簇
+        #pragma omp parallel for schedule(dynamic, 256)
+        for (int i = 0; i < n; ++i) {
+            if (point_features[i] == Corepoint) continue;
+            int best = -1;
+            forEachNeighbor(i, [&](int j) {
+                if (point_features[j] == Corepoint && (best < 0 || labels[j] < best)) {
+                    best = labels[j];
+                }
+            });
+            labels[i] = best;
+        }
+        recordChanges(label_history, before, labels);
+        point_feature_history.commit();
     }
 
     /**
@@ -96,10 +265,11 @@ public:
         std::queue<int> queue; // BFS队列
         queue.push(point);
         visited[point] = true;
+        label_history.record(point, labels[point], label); // 记录标签变化
         labels[point] = label; // 分配簇标签
 
-        label_history.push_back(labels); // 保存当前标签状态
-        point_feature_history.push_back(point_features);
+        label_history.commit();           // 每分配一个点为一帧
+        point_feature_history.commit();   // 点类型不变，记为空帧
 
         while (!queue.empty()) {
             int current = queue.front();
@@ -107,17 +277,18 @@ public:
 
             // 如果是核心点，则继续扩展
             if (point_features[current] == Corepoint) {
-                for (int neighbor : neighbors[current]) {
+                forEachNeighbor(current, [&](int neighbor) {
                     if (!visited[neighbor]) {
                         visited[neighbor] = true;
+                        label_history.record(neighbor, labels[neighbor], label);
                         labels[neighbor] = label; // 分配相同簇标签
 
-                        label_history.push_back(labels); // 保存状态
-                        point_feature_history.push_back(point_features);
+                        label_history.commit();
+                        point_feature_history.commit();
 
                         queue.push(neighbor);
                     }
-                }
+                });
             }
         }
     }
@@ -130,9 +301,7 @@ public:
         for (int i = 0; i < X.rows(); ++i) {
             // 如果是核心点且未被访问过
             if (point_features[i] == Corepoint && !visited[i]) {
-                labels[i] = label; // 设置簇标签
-                visited[i] = true;
-                expandCluster(i, label); // 扩展簇
+                expandCluster(i, label); // 设置簇标签并扩展簇
                 label++; // 下一个簇
             }
         }
@@ -143,7 +312,11 @@ public:
      */
     void start() {
         distance();         // 第一步：计算每个点的邻居和密度
-        update();           // 第二步：执行聚类
+        if (Parallel) {
+            unionClusters(); // 第二步：并行合并核心点并挂接边界点
+        } else {
+            update();       // 第二步：执行聚类
+        }
     }
 
 };
@@ -0,0 +1,168 @@
+#ifndef DENDROGRAM_H
+#define DENDROGRAM_H
+
+#include <vector>
+#include <algorithm>
+
+/**
+ * ClusterNode：聚类树中的一个节点（存放在 Dendrogram 的节点池中，子节点以下标引用）
+ */
+struct ClusterNode {
+    int id;                      // 节点 ID，即在节点池中的下标（叶子为数据点索引）
+    int height;                  // 树的高度，用于可视化或层次分析
+    double distance;             // 合并高度（链接距离；叶子为 0）
+    int begin;                   // 节点包含的样本在叶序排列中的起始位置
+    int end;                     // 叶序排列中的结束位置（不含）
+    int left;                    // 左子节点 ID（叶子为 -1）
+    int right;                   // 右子节点 ID（叶子为 -1）
+
+    bool isLeaf() const { return left < 0; }
+    int size() const { return end - begin; }
+};
+
+/**
+ * Dendrogram：层次聚类树的节点池
+ * 叶子 0..N-1 为各样本，第 m 次合并生成节点 N + m；节点连续存放，不单独分配、也不复制成员列表。
+ * 建树期间每个节点的成员以链表串联（合并即首尾相接，O(1)），finalize() 后链表展开为一个叶序排列，
+ * 任一节点包含的样本恰为 order[begin, end)。节点 ID 同时就是合并序列：前 m 次合并之后的簇
+ * 是 ID 小于 N + m 且尚未被（前 m 次中的）合并吸收的节点，因此任意一帧都可在 O(N) 内重建
+ */
+class Dendrogram {
+public:
+    std::vector<ClusterNode> nodes;  // 节点池（下标即节点 ID）
+    std::vector<int> order;          // 叶序排列（finalize() 后有效）
+    std::vector<int> parent;         // 父节点 ID（尚未被合并为 -1）
+
+    /**
+     * 构造函数
+     * @param n 叶子（样本）数量
+     */
+    explicit Dendrogram(int n = 0) : parent(n, -1), leaves(n), head(n), tail(n), next(n, -1), size(n, 1) {
+        nodes.reserve(n > 0 ? 2 * n - 1 : 0);
+        for (int i = 0; i < n; ++i) {
+            nodes.push_back(ClusterNode{i, 0, 0.0, -1, -1, -1, -1});
+            head[i] = i;
+            tail[i] = i;
+        }
+    }
+
+    int numLeaves() const { return leaves; }
+    int numMerges() const { return nodes.size() - leaves; }
+
+    const ClusterNode& operator[](int id) const { return nodes[id]; }
+
+    /**
+     * 合并两个当前根节点，生成新节点（左子树的成员排在右子树之前）
+     * @param dist 合并高度（链接距离）
+     * @return 新节点 ID
+     */
+    int merge(int a, int b, double dist = 0.0) {
+        int id = nodes.size();
+        nodes.push_back(ClusterNode{id, std::max(nodes[a].height, nodes[b].height) + 1, dist, -1, -1, a, b});
+        next[tail[a]] = head[b];
+        head.push_back(head[a]);
+        tail.push_back(tail[b]);
+        size.push_back(size[a] + size[b]);
+        parent.push_back(-1);
+        parent[a] = id;
+        parent[b] = id;
+        return id;
+    }
+
+    /**
+     * 依次访问节点包含的所有样本（建树期间沿成员链表，finalize() 后读取叶序区间）
+     */
+    template <typename Func>
+    void forEachMember(int id, Func f) const {
+        if (!order.empty()) {
+            for (int t = nodes[id].begin; t < nodes[id].end; ++t) f(order[t]);
+            return;
+        }
+        for (int i = head[id], k = 0; k < size[id]; i = next[i], ++k) f(i);
+    }
+
+    /**
+     * 展开成员链表：各棵树按根节点 ID 依次排列，得到叶序排列与每个节点的 [begin, end)
+     */
+    void finalize() {
+        order.clear();
+        order.reserve(leaves);
+        std::vector<int> pos(leaves);
+        for (size_t r = 0; r < nodes.size(); ++r) {
+            if (parent[r] >= 0) continue;
+            for (int i = head[r], k = 0; k < size[r]; i = next[i], ++k) {
+                pos[i] = order.size();
+                order.push_back(i);
+            }
+        }
+        for (size_t id = 0; id < nodes.size(); ++id) {
+            nodes[id].begin = pos[head[id]];
+            nodes[id].end = nodes[id].begin + size[id];
+        }
+        // 区间已能表达全部成员，释放建树期间的链表
+        std::vector<int>().swap(head);
+        std::vector<int>().swap(tail);
+        std::vector<int>().swap(next);
+        std::vector<int>().swap(size);
+    }
+
+    /**
+     * 节点在前 m 次合并之后是否为当前簇（已生成且尚未被合并）
+     */
+    bool isRootAfter(int id, int m) const {
+        return id < leaves + m && (parent[id] < 0 || parent[id] >= leaves + m);
+    }
+
+    /**
+     * 前 m 次合并之后的所有簇（按节点 ID 升序），O(N)
+     */
+    std::vector<int> rootsAfter(int m) const {
+        std::vector<int> roots;
+        roots.reserve(leaves - m);
+        for (int id = 0; id < leaves + m; ++id) {
+            if (isRootAfter(id, m)) roots.push_back(id);
+        }
+        return roots;
+    }
+
+    /**
+     * 前 m 次合并之后的标签：簇按节点 ID 升序编号，每个簇的样本为其叶序区间，O(N)（需先 finalize()）
+     */
+    std::vector<int> labelsAfter(int m) const {
+        std::vector<int> labels(leaves);
+        int label = 0;
+        for (int id = 0; id < leaves + m; ++id) {
+            if (!isRootAfter(id, m)) continue;
+            for (int t = nodes[id].begin; t < nodes[id].end; ++t) labels[order[t]] = label;
+            label++;
+        }
+        return labels;
+    }
+
+    /**
+     * 切成 k 个簇（k 截断到 [1, N]）：即前 N - k 次合并之后的标签，O(N)
+     */
+    std::vector<int> cutAtK(int k) const {
+        k = std::min(std::max(k, 1), leaves);
+        return labelsAfter(leaves - k);
+    }
+
+    /**
+     * 在高度 h 处切开：执行所有合并高度不超过 h 的合并（合并按高度非降顺序生成，
+     * 遇到第一个高于 h 的合并即停止），O(N)
+     */
+    std::vector<int> cutAtHeight(double h) const {
+        int m = 0;
+        while (m < numMerges() && nodes[leaves + m].distance <= h) m++;
+        return labelsAfter(m);
+    }
+
+private:
+    int leaves;                     // 叶子数量
+    std::vector<int> head;          // 每个节点成员链表的首个样本
+    std::vector<int> tail;          // 每个节点成员链表的最后一个样本
+    std::vector<int> next;          // 样本在所属链表中的后继
+    std::vector<int> size;          // 每个节点包含的样本数
+};
+
+#endif // DENDROGRAM_H
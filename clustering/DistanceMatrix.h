@@ -0,0 +1,156 @@
+#ifndef DISTANCEMATRIX_H
+#define DISTANCEMATRIX_H
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <Eigen/Dense>
+
+/**
+ * CondensedDistance：压缩存储的成对距离矩阵
+ * 距离矩阵对称且对角线为 0，只按行保存上三角 N(N - 1) / 2 个元素（第 i 行的 j > i 部分连续存放），
+ * 可选以 float 存储；两者合计使成对距离的内存降为完整 double 矩阵的 1/4。
+ * 计算按 TileSize × TileSize 的分块进行，每块写入的各行片段在存储中连续
+ */
+class CondensedDistance {
+public:
+    static constexpr int TileSize = 64;     // 分块计算的块大小（行数）
+
+    CondensedDistance() : n(0), single(false) {}
+
+    /**
+     * 构造并计算数据集的成对距离
+     * @param X 数据集（每行一个样本）
+     * @param squared 是否保存平方距离
+     * @param useFloat 是否以 float 存储
+     */
+    CondensedDistance(const Eigen::MatrixXd& X, bool squared = false, bool useFloat = false) {
+        compute(X, squared, useFloat);
+    }
+
+    /**
+     * 分块计算成对欧氏距离：直接对坐标差求平方和（避免 |xi|² + |xj|² - 2 xi·xj 的相消误差，
+     * 坐标相同的点对距离严格相等），两块样本在计算期间常驻缓存
+     */
+    void compute(const Eigen::MatrixXd& X, bool squared = false, bool useFloat = false) {
+        n = X.rows();
+        single = useFloat;
+        std::size_t total = n > 1 ? static_cast<std::size_t>(n) * (n - 1) / 2 : 0;
+        std::vector<double>().swap(d64);
+        std::vector<float>().swap(f32);
+        if (single) f32.resize(total);
+        else d64.resize(total);
+
+        Eigen::MatrixXd XT = X.transpose();     // 每列一个样本，坐标连续存放
+        int d = X.cols();
+        int tiles = (n + TileSize - 1) / TileSize;
+
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (int bi = 0; bi < tiles; ++bi) {
+            int i0 = bi * TileSize;
+            int ni = std::min(TileSize, n - i0);
+            for (int bj = bi; bj < tiles; ++bj) {
+                int j0 = bj * TileSize;
+                int nj = std::min(TileSize, n - j0);
+                for (int a = 0; a < ni; ++a) {
+                    int i = i0 + a;
+                    int b0 = bj == bi ? a + 1 : 0;
+                    if (b0 >= nj) continue;
+                    std::size_t k = index(i, j0 + b0);
+                    const double* xi = XT.data() + static_cast<std::size_t>(i) * d;
+                    for (int b = b0; b < nj; ++b, ++k) {
+                        const double* xj = XT.data() + static_cast<std::size_t>(j0 + b) * d;
+                        double v = 0.0;
+                        for (int t = 0; t < d; ++t) {
+                            double diff = xi[t] - xj[t];
+                            v += diff * diff;
+                        }
+                        if (!squared) v = std::sqrt(v);
+                        if (single) f32[k] = static_cast<float>(v);
+                        else d64[k] = v;
+                    }
+                }
+            }
+        }
+    }
+
+    int rows() const { return n; }
+    std::size_t size() const { return single ? f32.size() : d64.size(); } // 保存的点对数
+    bool isFloat() const { return single; }
+
+    /**
+     * 读取 i、j 之间的距离（i == j 时为 0）
+     */
+    double operator()(int i, int j) const {
+        if (i == j) return 0.0;
+        std::size_t k = i < j ? index(i, j) : index(j, i);
+        return single ? f32[k] : d64[k];
+    }
+
+    /**
+     * 把第 i 行的全部 N 个距离写入 out（out[i] 为 0）：j > i 部分是存储中连续的一段，
+     * j < i 部分沿上三角的第 i 列读取，下标逐步累加，不逐元素计算位置
+     */
+    void row(int i, double* out) const {
+        std::size_t k = i > 0 ? index(0, i) : 0;
+        for (int j = 0; j < i; ++j) {
+            out[j] = single ? f32[k] : d64[k];
+            k += n - j - 2;
+        }
+        out[i] = 0.0;
+        if (i + 1 >= n) return;
+        k = index(i, i + 1);
+        if (single) {
+            for (int j = i + 1; j < n; ++j, ++k) out[j] = f32[k];
+        } else {
+            std::copy(d64.begin() + k, d64.begin() + k + (n - i - 1), out + i + 1);
+        }
+    }
+
+    /**
+     * 写入 i、j 之间的距离（i != j，对称位置同时生效）
+     */
+    void set(int i, int j, double v) {
+        std::size_t k = i < j ? index(i, j) : index(j, i);
+        if (single) f32[k] = static_cast<float>(v);
+        else d64[k] = v;
+    }
+
+    /**
+     * 移出 double 存储（按行的上三角，需以 double 计算），之后矩阵为空；调用方可原地改写这块缓冲
+     */
+    std::vector<double> takeDouble() {
+        n = 0;
+        return std::move(d64);
+    }
+
+    /**
+     * 所有点对距离中第 k 小的值（0 起），不修改存储
+     */
+    double nthSmallest(std::size_t k) const {
+        if (single) {
+            std::vector<float> v(f32);
+            std::nth_element(v.begin(), v.begin() + k, v.end());
+            return v[k];
+        }
+        std::vector<double> v(d64);
+        std::nth_element(v.begin(), v.begin() + k, v.end());
+        return v[k];
+    }
+
+private:
+    int n;                          // 样本数
+    bool single;                    // 是否以 float 存储
+    std::vector<double> d64;        // double 存储
+    std::vector<float> f32;         // float 存储
+
+    /**
+     * 上三角 (i, j)（i < j）在压缩存储中的位置
+     */
+    std::size_t index(int i, int j) const {
+        return static_cast<std::size_t>(i) * (2 * static_cast<std::size_t>(n) - i - 1) / 2 + (j - i - 1);
+    }
+};
+
+#endif // DISTANCEMATRIX_H
@@ -0,0 +1,92 @@
+#ifndef EVENTHISTORY_H
+#define EVENTHISTORY_H
+
+#include <vector>
+#include <algorithm>            // 提供 upper_bound
+
+/**
+ * EventHistory：以“变化事件 + 周期性关键帧”记录逐步变化的状态向量（如标签、点类型）
+ * 每帧只保存本帧内改动的 (下标, 旧值, 新值)，任意一帧可由其之前最近的关键帧回放事件得到；
+ * 自上一个关键帧以来的事件数达到状态长度时才保存新的关键帧，因此关键帧总内存不超过事件本身
+ * @tparam T 状态元素类型
+ */
+template <typename T>
+class EventHistory {
+public:
+    /**
+     * Event：一次元素变化
+     */
+    struct Event {
+        int index;              // 发生变化的元素下标
+        T before;               // 变化前的值
+        T after;                // 变化后的值
+    };
+
+    EventHistory() {}
+
+    /**
+     * 清空历史并设置初始状态（第 0 帧之前的状态）
+     * @param initial 初始状态
+     */
+    void reset(const std::vector<T>& initial) {
+        current_ = initial;
+        events_.clear();
+        frameEnd_.clear();
+        keyframes_.assign(1, initial);
+        keyFrameAt_.assign(1, -1);
+        keyEventAt_.assign(1, 0);
+    }
+
+    /**
+     * 在当前（尚未提交的）帧中记录一次变化
+     * @param index 元素下标
+     * @param before 变化前的值
+     * @param after 变化后的值
+     */
+    void record(int index, const T& before, const T& after) {
+        events_.push_back(Event{index, before, after});
+        current_[index] = after;
+    }
+
+    /**
+     * 提交当前帧（允许没有任何事件的空帧），必要时保存关键帧
+     */
+    void commit() {
+        frameEnd_.push_back(events_.size());
+        size_t since = events_.size() - keyEventAt_.back();
+        if (since >= std::max<size_t>(1, current_.size())) {
+            keyframes_.push_back(current_);
+            keyFrameAt_.push_back(frameEnd_.size() - 1);
+            keyEventAt_.push_back(events_.size());
+        }
+    }
+
+    /**
+     * 重建第 f 帧结束时的完整状态
+     * @param f 帧下标（0 ≤ f < size()）
+     * @return 该帧的状态
+     */
+    std::vector<T> frame(int f) const {
+        // 找到不晚于 f 的最近关键帧
+        int k = std::upper_bound(keyFrameAt_.begin(), keyFrameAt_.end(), f) - keyFrameAt_.begin() - 1;
+        std::vector<T> state = keyframes_[k];
+        for (size_t e = keyEventAt_[k]; e < frameEnd_[f]; ++e) {
+            state[events_[e].index] = events_[e].after;
+        }
+        return state;
+    }
+
+    int size() const { return frameEnd_.size(); }
+    bool empty() const { return frameEnd_.empty(); }
+    const std::vector<Event>& events() const { return events_; }
+
+private:
+    std::vector<T> current_;                // 最新状态（记录时维护）
+    std::vector<Event> events_;             // 所有事件（按时间顺序）
+    std::vector<size_t> frameEnd_;          // 每帧结束时的事件数
+    std::vector<std::vector<T>> keyframes_; // 关键帧状态（第一个为初始状态）
+    std::vector<int> keyFrameAt_;           // 每个关键帧对应的帧下标（初始状态为 -1）
+    std::vector<size_t> keyEventAt_;        // 每个关键帧对应的事件数
+};
+
+#endif // EVENTHISTORY_H
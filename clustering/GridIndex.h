@@ -0,0 +1,197 @@
+#ifndef GRIDINDEX_H
+#define GRIDINDEX_H
+
+#include <vector>
+#include <unordered_map>
+#include <cmath>
+#include <algorithm>            // 提供 sort、find
+#include <Eigen/Dense>
+
+/**
+ * GridIndex：以固定边长的均匀网格对数据集做空间哈希
+ * 半径不超过边长的邻域查询只需检查所在单元及其相邻单元（二维为 3 × 3 个），
+ * 供 DBSCAN 等基于 Eps 邻域的算法使用
+ */
+class GridIndex {
+public:
+    static constexpr int MaxGridDim = 4;    // 超过该维度时相邻单元数 3^D 过多，退化为单个单元（逐点比较）
+
+    using Key = std::vector<long long>;     // 单元坐标
+
+    /**
+     * KeyHash：单元坐标的哈希函数
+     */
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            size_t h = 0;
+            for (long long v : key) {
+                h ^= std::hash<long long>()(v) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+            }
+            return h;
+        }
+    };
+
+    GridIndex() {}
+
+    /**
+     * 构造函数：建立空的动态网格，之后用 insert / erase 增删样本
+     * （动态样本的坐标由调用方保存，只能通过 forEachNeighborCell 查询）
+     * @param dim 数据维度
+     * @param cellsize 网格边长
+     */
+    GridIndex(int dim, double cellsize)
+        : cellSize_(cellsize) {
+        gridded_ = dim <= MaxGridDim && cellsize > 0;
+        initOffsets(dim);
+    }
+
+    /**
+     * 构造函数：把每个样本放入其所在的网格单元
+     * @param data 数据矩阵（每行一个样本）
+     * @param cellsize 网格边长（通常取邻域半径 Eps）
+     */
+    GridIndex(const Eigen::MatrixXd& data, double cellsize)
+        : data_(data), cellSize_(cellsize) {
+        int d = data.cols();
+        gridded_ = d <= MaxGridDim && cellsize > 0;
+        initOffsets(d);
+
+        for (int i = 0; i < data.rows(); ++i) {
+            insert(i, data.row(i)); // 单元内下标按升序排列
+        }
+    }
+
+    /**
+     * 把样本 i 放入点 p 所在的单元
+     * @param i 样本下标
+     * @param p 样本坐标
+     */
+    void insert(int i, const Eigen::RowVectorXd& p) {
+        Key key = cellOf(p);
+        auto it = index_.find(key);
+        if (it == index_.end()) {
+            it = index_.emplace(key, cells_.size()).first;
+            cells_.push_back(std::vector<int>());
+        }
+        cells_[it->second].push_back(i);
+    }
+
+    /**
+     * 从点 p 所在的单元中移除样本 i（空单元保留，供之后复用）
+     * @param i 样本下标
+     * @param p 样本坐标（须与插入时相同）
+     */
+    void erase(int i, const Eigen::RowVectorXd& p) {
+        auto it = index_.find(cellOf(p));
+        if (it == index_.end()) return;
+        std::vector<int>& cell = cells_[it->second];
+        auto pos = std::find(cell.begin(), cell.end(), i);
+        if (pos != cell.end()) {
+            *pos = cell.back();
+            cell.pop_back();
+        }
+    }
+
+    /**
+     * 查询第 i 个样本半径 radius 内的所有其它样本
+     * @param i 样本下标
+     * @param radius 查询半径（不超过网格边长）
+     * @return 邻居下标（升序，不含 i 本身）
+     */
+    std::vector<int> radiusSearch(int i, double radius) const {
+        std::vector<int> result;
+        double r_sq = radius * radius;
+        forEachNeighborCell(data_.row(i), [&](const std::vector<int>& cell) {
+            for (int j : cell) {
+                if (j != i && (data_.row(i) - data_.row(j)).squaredNorm() <= r_sq) {
+                    result.push_back(j);
+                }
+            }
+        });
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    /**
+     * 统计第 i 个样本半径 radius 内其它样本的个数（不保存下标）
+     * @param i 样本下标
+     * @param radius 查询半径（不超过网格边长）
+     * @return 邻居个数
+     */
+    int radiusCount(int i, double radius) const {
+        int count = 0;
+        double r_sq = radius * radius;
+        forEachNeighborCell(data_.row(i), [&](const std::vector<int>& cell) {
+            for (int j : cell) {
+                if (j != i && (data_.row(i) - data_.row(j)).squaredNorm() <= r_sq) {
+                    count++;
+                }
+            }
+        });
+        return count;
+    }
+
+    /**
+     * 对点 p 所在单元及其相邻单元中的每个非空单元调用 f(单元内样本下标列表)
+     * @param p 查询点
+     * @param f 回调函数
+     */
+    template <typename Func>
+    void forEachNeighborCell(const Eigen::RowVectorXd& p, Func f) const {
+        Key center = cellOf(p);
+        Key key(center.size());
+        for (const Key& o : offsets_) {
+            for (size_t j = 0; j < center.size(); ++j) {
+                key[j] = center[j] + o[j];
+            }
+            auto it = index_.find(key);
+            if (it != index_.end()) {
+                f(cells_[it->second]);
+            }
+        }
+    }
+
+    const Eigen::MatrixXd& data() const { return data_; }
+
+private:
+    Eigen::MatrixXd data_;                      // 建立索引用的数据
+    double cellSize_ = 0.0;                     // 网格边长
+    bool gridded_ = false;                      // 是否真正分格（否则所有点都在同一个单元）
+    std::vector<Key> offsets_;                  // 相邻单元的偏移量（含自身）
+    std::vector<std::vector<int>> cells_;       // 每个非空单元内的样本下标
+    std::unordered_map<Key, int, KeyHash> index_; // 单元坐标 -> cells_ 中的下标
+
+    /**
+     * 生成相邻单元的偏移量：每一维取 -1、0、1（不分格时只有自身）
+     */
+    void initOffsets(int d) {
+        offsets_.assign(1, Key(gridded_ ? d : 0, 0));
+        for (int j = 0; gridded_ && j < d; ++j) {
+            std::vector<Key> next;
+            for (const Key& o : offsets_) {
+                for (int delta = -1; delta <= 1; ++delta) {
+                    Key k = o;
+                    k[j] = delta;
+                    next.push_back(k);
+                }
+            }
+            offsets_ = next;
+        }
+    }
+
+    /**
+     * 计算点所在的单元坐标
+     */
+    Key cellOf(const Eigen::RowVectorXd& p) const {
+        if (!gridded_) {
+            return Key();
+        }
+        Key key(p.size());
+        for (int j = 0; j < p.size(); ++j) {
+            key[j] = static_cast<long long>(std::floor(p(j) / cellSize_));
+        }
+        return key;
+    }
+};
+
+#endif // GRIDINDEX_H
@@ -0,0 +1,271 @@
+#ifndef HDBSCAN_H
+#define HDBSCAN_H
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <memory>
+#include <Eigen/Dense>
+#include "Dendrogram.h"         // 供树窗口显示的聚类树节点池
+#include "KDTree.h"             // 核心距离的 k 近邻查询
+#include "MST.h"                // 互可达距离最小生成树
+
+/**
+ * HDBSCAN*：基于互可达距离层次结构的密度聚类（Hierarchical DBSCAN）
+ * 相当于一次性对所有 eps 运行 DBSCAN：在互可达距离 max(core(a), core(b), |a - b|) 上求最小生成树，
+ * 按边权得到单链接层次树，再以最小簇大小压缩并选出稳定性最大的一组簇
+ */
+class HDBSCAN {
+private:
+    int Minpts;                     // 核心距离取第 Minpts 个最近邻（不含自身，与 DBSCAN 一致）
+    int MinClusterSize;             // 最小簇大小（压缩树中小于该值的分裂视为点脱离）
+    Eigen::MatrixXd X;              // 输入数据集（每行一个样本）
+    KDTree<double> Tree;            // 数据集上的 kd 树
+
+    static constexpr int PrimThreshold = 2048;  // 样本数不超过该值（或维度较高）时直接用 Prim 求最小生成树
+    static constexpr int MaxTreeDim = 8;        // 超过该维度时 kd 树剪枝失效，Borůvka 退化为 Prim
+
+    // 单链接层次树：第 m 次合并生成节点 N + m
+    std::vector<int> slLeft;        // 左子节点
+    std::vector<int> slRight;       // 右子节点
+    std::vector<double> slDist;     // 合并时的互可达距离
+    std::vector<int> slSize;        // 节点包含的点数
+
+    // 压缩树：簇 0 为根，子簇编号总大于父簇
+    std::vector<int> clusterParent;         // 父簇（根为 -1）
+    std::vector<double> clusterBirth;       // 簇出现时的 λ = 1 / 距离
+    std::vector<double> clusterStability;   // 簇的稳定性 Σ (λ_脱离 - λ_出现)
+    std::vector<int> pointCluster;          // 每个点脱离时所在的簇
+    std::vector<double> pointLambda;        // 每个点脱离时的 λ
+
+public:
+    std::vector<double> core_dist;          // 每个点的核心距离
+    std::vector<MSTEdge> mst;               // 互可达距离最小生成树（按边权升序）
+    std::vector<int> labels;                // 聚类标签（-1 表示噪声）
+    std::vector<double> probs;              // 隶属强度：λ_点 / λ_簇内最大，噪声为 0
+    std::shared_ptr<Dendrogram> tree;       // 单链接层次树（节点 ID 与 slLeft / slRight 一致）
+    std::vector<int> roots;                 // 单链接层次树的根节点 ID
+    std::vector<bool> selected;             // 每个压缩树簇是否被选为最终簇
+
+    /**
+     * 构造函数
+     * @param minpts 核心距离所用的近邻数
+     * @param minclustersize 最小簇大小（不大于 0 时取 minpts，至少为 2）
+     * @param x 数据集（每行一个样本）
+     */
+    HDBSCAN(int minpts, int minclustersize, Eigen::MatrixXd x)
+        : Minpts(std::max(0, minpts)), MinClusterSize(minclustersize > 0 ? minclustersize : minpts), X(x) {
+        MinClusterSize = std::max(2, MinClusterSize);
+        int n = X.rows();
+        labels = std::vector<int>(n, -1);
+        probs = std::vector<double>(n, 0.0);
+    }
+
+    /**
+     * 用 kd 树 k 近邻查询计算每个点的核心距离
+     */
+    void coreDistance() {
+        int n = X.rows();
+        Tree = KDTree<double>(X);
+        core_dist = std::vector<double>(n, 0.0);
+        int k = std::min(Minpts + 1, n); // 查询结果包含点自身
+
+        #pragma omp parallel for schedule(dynamic, 256)
+        for (int i = 0; i < n; ++i) {
+            std::vector<int> idx;
+            std::vector<double> dist;
+            Tree.knnSearch(X.row(i).transpose(), k, idx, dist);
+            core_dist[i] = dist.back();
+        }
+    }
+
+    /**
+     * 求互可达距离最小生成树：小规模或高维数据用 Prim，其余用 kd 树上的 Borůvka
+     */
+    void spanningTree() {
+        if (X.rows() <= PrimThreshold || X.cols() > MaxTreeDim) {
+            mst = primMST(X, core_dist);
+        } else {
+            mst = boruvkaMST(Tree, core_dist);
+        }
+        std::sort(mst.begin(), mst.end());
+    }
+
+    /**
+     * 按边权从小到大用并查集合并，得到单链接层次树，并同步在节点池中生成供树窗口显示的节点
+     */
+    void buildHierarchy() {
+        int n = X.rows();
+        int m = mst.size();
+        slLeft.assign(m, -1);
+        slRight.assign(m, -1);
+        slDist.assign(m, 0.0);
+        slSize.assign(n + m, 1);
+
+        tree = std::make_shared<Dendrogram>(n);
+
+        DisjointSet dsu(n);
+        std::vector<int> top(n);        // 每个并查集根当前对应的层次树节点
+        for (int i = 0; i < n; ++i) top[i] = i;
+
+        for (int e = 0; e < m; ++e) {
+            int a = dsu.find(mst[e].u);
+            int b = dsu.find(mst[e].v);
+            int id = n + e;
+            slLeft[e] = top[a];
+            slRight[e] = top[b];
+            slDist[e] = mst[e].weight;
+            slSize[id] = slSize[top[a]] + slSize[top[b]];
+            tree->merge(top[a], top[b], mst[e].weight);
+
+            top[dsu.unite(a, b)] = id;
+        }
+        tree->finalize();
+
+        roots.clear();
+        if (n > 0) roots.push_back(n + m - 1);
+    }
+
+    /**
+     * 压缩层次树：自根向下，两侧都不小于最小簇大小的分裂产生两个子簇，
+     * 较小一侧的点在该 λ 处“脱离”所在簇，另一侧沿用原簇
+     */
+    void condense() {
+        int n = X.rows();
+        clusterParent.assign(1, -1);
+        clusterBirth.assign(1, 0.0);
+        clusterStability.assign(1, 0.0);
+        pointCluster.assign(n, 0);
+        pointLambda.assign(n, 0.0);
+        if (n <= 1) return;
+
+        auto lambdaOf = [](double d) { return 1.0 / std::max(d, 1e-300); };
+
+        // 子树中的所有点在 λ 处脱离簇 c
+        auto fallOut = [&](int root, int c, double lambda) {
+            std::vector<int> stack(1, root);
+            while (!stack.empty()) {
+                int v = stack.back();
+                stack.pop_back();
+                if (v < n) {
+                    pointCluster[v] = c;
+                    pointLambda[v] = lambda;
+                    clusterStability[c] += lambda - clusterBirth[c];
+                } else {
+                    stack.push_back(slLeft[v - n]);
+                    stack.push_back(slRight[v - n]);
+                }
+            }
+        };
+        auto newCluster = [&](int parent, double lambda, int size) {
+            clusterParent.push_back(parent);
+            clusterBirth.push_back(lambda);
+            clusterStability.push_back(0.0);
+            clusterStability[parent] += (lambda - clusterBirth[parent]) * size;
+            return static_cast<int>(clusterParent.size()) - 1;
+        };
+
+        std::vector<std::pair<int, int>> stack(1, std::make_pair(n + static_cast<int>(slDist.size()) - 1, 0));
+        while (!stack.empty()) {
+            int v = stack.back().first;
+            int c = stack.back().second;
+            stack.pop_back();
+
+            int e = v - n;
+            double lambda = lambdaOf(slDist[e]);
+            int l = slLeft[e], r = slRight[e];
+            bool bigL = slSize[l] >= MinClusterSize;
+            bool bigR = slSize[r] >= MinClusterSize;
+
+            if (bigL && bigR) {
+                stack.push_back(std::make_pair(l, newCluster(c, lambda, slSize[l])));
+                stack.push_back(std::make_pair(r, newCluster(c, lambda, slSize[r])));
+            } else {
+                if (!bigL) fallOut(l, c, lambda);
+                if (!bigR) fallOut(r, c, lambda);
+                if (bigL) stack.push_back(std::make_pair(l, c));
+                if (bigR) stack.push_back(std::make_pair(r, c));
+            }
+        }
+    }
+
+    /**
+     * 按稳定性选簇（Excess of Mass）：自底向上比较簇自身与其子簇稳定性之和，保留较大者；
+     * 根簇不参与选择（整个数据集不作为一个簇）
+     */
+    void selectClusters() {
+        int k = clusterParent.size();
+        std::vector<double> best(k, 0.0);   // 子树内可获得的最大稳定性之和
+        std::vector<double> childSum(k, 0.0);
+        std::vector<bool> hasChild(k, false);
+        selected.assign(k, false);
+
+        for (int c = k - 1; c >= 1; --c) {
+            if (!hasChild[c] || clusterStability[c] >= childSum[c]) {
+                selected[c] = true;
+                best[c] = clusterStability[c];
+            } else {
+                best[c] = childSum[c];
+            }
+            childSum[clusterParent[c]] += best[c];
+            hasChild[clusterParent[c]] = true;
+        }
+
+        // 已选簇的后代全部取消选择（父簇编号总小于子簇）
+        std::vector<bool> covered(k, false);
+        for (int c = 1; c < k; ++c) {
+            int p = clusterParent[c];
+            covered[c] = p > 0 && (covered[p] || selected[p]);
+            if (covered[c]) selected[c] = false;
+        }
+    }
+
+    /**
+     * 由选出的簇生成标签与隶属强度：点归属其脱离簇的已选祖先，否则为噪声
+     */
+    void assignLabels() {
+        int n = X.rows();
+        int k = clusterParent.size();
+        std::vector<int> owner(k, -1);      // 每个压缩树簇所属的已选簇
+        for (int c = 1; c < k; ++c) {
+            owner[c] = selected[c] ? c : owner[clusterParent[c]];
+        }
+
+        // 已选簇按首次出现的样本下标编号
+        std::vector<int> remap(k, -1);
+        std::vector<double> lambdaMax(k, 0.0);
+        int next = 0;
+        for (int i = 0; i < n; ++i) {
+            int s = owner[pointCluster[i]];
+            if (s < 0) continue;
+            if (remap[s] < 0) remap[s] = next++;
+            lambdaMax[s] = std::max(lambdaMax[s], pointLambda[i]);
+        }
+        for (int i = 0; i < n; ++i) {
+            int s = owner[pointCluster[i]];
+            if (s < 0) {
+                labels[i] = -1;
+                probs[i] = 0.0;
+            } else {
+                labels[i] = remap[s];
+                probs[i] = lambdaMax[s] > 0 ? std::min(pointLambda[i], lambdaMax[s]) / lambdaMax[s] : 1.0;
+            }
+        }
+    }
+
+    /**
+     * 启动 HDBSCAN*：核心距离 → 最小生成树 → 单链接层次树 → 压缩树 → 选簇
+     */
+    void start() {
+        if (X.rows() == 0) return;
+        coreDistance();
+        spanningTree();
+        buildHierarchy();
+        condense();
+        selectClusters();
+        assignLabels();
+    }
+
+};
+
+#endif // HDBSCAN_H
@@ -0,0 +1,359 @@
+#ifndef INCREMENTALDBSCAN_H
+#define INCREMENTALDBSCAN_H
+
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <algorithm>
+#include <Eigen/Dense>
+#include "DBSCAN.h"             // Pointtype
+#include "GridIndex.h"          // 动态网格索引
+#include "MST.h"                // DisjointSet
+
+/**
+ * IncrementalDBSCAN：支持逐点插入与删除的 DBSCAN（Ester 等人的增量算法）
+ * 网格索引、密度与簇结构在调用之间一直保留，插入或删除一个点只更新其 Eps 邻域内的密度与核心状态，
+ * 并在受影响的核心点之间合并簇（插入）或检查簇是否断开（删除），代价只与局部邻域有关而与 N 无关
+ */
+class IncrementalDBSCAN {
+public:
+    using RowMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+private:
+    double Eps;                     // 邻域半径
+    int Minpts;                     // 成为核心点所需的最小邻域点数（不含自身，与 DBSCAN 一致）
+    int Dim;                        // 数据维度
+    GridIndex Grid;                 // 以 Eps 为边长的动态网格
+
+    RowMatrix points;               // 样本坐标（按编号存放，容量按需倍增）
+    std::vector<char> alive;        // 编号是否仍在使用
+    std::vector<int> freeIds;       // 已删除、可复用的编号
+    std::vector<int> density;       // 每个点 Eps 邻域内其它点的个数
+    std::vector<int> raw;           // 每个点所属簇的编号（经 clusterParent 查找代表元，-1 为噪声）
+    std::vector<int> clusterParent; // 簇编号的并查集（合并簇时只改父节点）
+    int count = 0;                  // 当前点数
+
+public:
+    /**
+     * 构造函数
+     * @param eps 邻域半径
+     * @param minpts 最小邻域点数
+     * @param dim 数据维度
+     */
+    IncrementalDBSCAN(double eps, int minpts, int dim)
+        : Eps(eps), Minpts(minpts), Dim(dim), Grid(dim, eps), points(0, dim) {}
+
+    double eps() const { return Eps; }
+    int minpts() const { return Minpts; }
+    int dim() const { return Dim; }
+    int size() const { return count; }
+
+    bool isCore(int i) const { return density[i] >= Minpts; }
+
+    /**
+     * 第 i 个点的簇编号（簇编号在增删过程中保持不变，但不连续；-1 为噪声）
+     */
+    int label(int i) {
+        return raw[i] < 0 ? -1 : findCluster(raw[i]);
+    }
+
+    /**
+     * 第 i 个点的类型（与 DBSCAN::classify 相同，只由密度决定）
+     */
+    Pointtype pointType(int i) const {
+        if (density[i] >= Minpts) return Corepoint;
+        if (density[i] > 0) return Marginpoint;
+        return Noisepoint;
+    }
+
+    /**
+     * 插入一个点：更新邻居密度，新成为核心的点与其相邻核心点所在的簇合并，必要时新建簇
+     * @param p 点坐标
+     * @return 新点的编号（之后用于删除与查询）
+     */
+    int insert(const Eigen::RowVectorXd& p) {
+        int id = allocate();
+        points.row(id) = p;
+        alive[id] = 1;
+        count++;
+
+        std::vector<int> nb = neighbors(id);
+        Grid.insert(id, p);
+        density[id] = nb.size();
+        raw[id] = -1;
+
+        // 恰好在本次插入后达到 Minpts 的点成为新的核心点
+        std::vector<int> newCores;
+        for (int q : nb) {
+            if (++density[q] == Minpts) newCores.push_back(q);
+        }
+        if (isCore(id)) newCores.push_back(id);
+
+        for (int c : newCores) {
+            // 新核心点连接了其邻域内所有核心点所在的簇
+            int cluster = -1;
+            std::vector<int> cnb = c == id ? nb : neighbors(c);
+            for (int q : cnb) {
+                if (!isCore(q) || raw[q] < 0 || q == c) continue;
+                int r = findCluster(raw[q]);
+                if (cluster < 0) cluster = r;
+                else if (r != cluster) cluster = mergeClusters(cluster, r);
+            }
+            if (cluster < 0) cluster = newCluster();
+            raw[c] = cluster;
+
+            // 尚未归属任何簇的非核心邻居成为该簇的边界点
+            for (int q : cnb) {
+                if (!isCore(q) && label(q) < 0) raw[q] = cluster;
+            }
+        }
+
+        if (!isCore(id)) raw[id] = borderCluster(id, nb);
+        return id;
+    }
+
+    /**
+     * 删除一个点：更新邻居密度，失去核心状态的点降为边界点或噪声，
+     * 并检查原来经由这些核心点相连的簇是否因此断开
+     * @param id 点的编号
+     */
+    void remove(int id) {
+        if (id < 0 || id >= static_cast<int>(alive.size()) || !alive[id]) return;
+
+        std::vector<int> nb = neighbors(id);
+        bool wasCore = isCore(id);
+        Grid.erase(id, points.row(id));
+        alive[id] = 0;
+        freeIds.push_back(id);
+        count--;
+        density[id] = 0;
+        raw[id] = -1;
+
+        std::vector<int> lostCores;
+        for (int q : nb) {
+            if (density[q]-- == Minpts) lostCores.push_back(q);
+        }
+
+        // 可能断开的簇：失去的核心点（含被删点）周围仍为核心的点作为连通性检查的起点
+        std::vector<int> seeds;
+        std::vector<int> touched = nb;  // 需要重新确定边界归属的点
+        if (wasCore) {
+            for (int q : nb) {
+                if (isCore(q)) seeds.push_back(q);
+            }
+        }
+        for (int c : lostCores) {
+            std::vector<int> cnb = neighbors(c);
+            for (int q : cnb) {
+                if (isCore(q)) seeds.push_back(q);
+                else touched.push_back(q);
+            }
+        }
+
+        // 非核心点重新挂接：优先保留当前所在的簇
+        for (int q : touched) {
+            if (!isCore(q)) raw[q] = borderCluster(q, neighbors(q));
+        }
+
+        // 按簇分组后逐簇检查连通性
+        std::sort(seeds.begin(), seeds.end());
+        seeds.erase(std::unique(seeds.begin(), seeds.end()), seeds.end());
+        std::unordered_map<int, std::vector<int>> groups;
+        for (int s : seeds) {
+            groups[label(s)].push_back(s);
+        }
+        for (auto& g : groups) {
+            if (g.second.size() > 1) splitCluster(g.first, g.second);
+        }
+    }
+
+    /**
+     * 导出一组点的标签与点类型：簇按最小核心点在 ids 中的位置重新编号为 0, 1, 2, ...，
+     * 同时与多个簇相邻的边界点归入编号最小的簇（ids 按原数据顺序给出时，结果与 DBSCAN 完全相同）
+     * @param ids 点的编号
+     * @param labels 输出：标签（-1 表示噪声）
+     * @param features 输出：点类型
+     */
+    void snapshot(const std::vector<int>& ids, std::vector<int>& labels, std::vector<Pointtype>& features) {
+        std::unordered_map<int, int> remap;
+        for (int id : ids) {
+            if (isCore(id)) remap.emplace(label(id), static_cast<int>(remap.size()));
+        }
+        labels.assign(ids.size(), -1);
+        features.assign(ids.size(), Noisepoint);
+        for (size_t i = 0; i < ids.size(); ++i) {
+            int id = ids[i];
+            features[i] = pointType(id);
+            if (features[i] == Corepoint) {
+                labels[i] = remap[label(id)];
+            } else if (features[i] == Marginpoint && raw[id] >= 0) {
+                for (int q : neighbors(id)) {
+                    if (!isCore(q)) continue;
+                    auto it = remap.find(label(q));
+                    if (it != remap.end() && (labels[i] < 0 || it->second < labels[i])) labels[i] = it->second;
+                }
+            }
+        }
+    }
+
+private:
+    /**
+     * 分配一个点编号（优先复用已删除的编号）
+     */
+    int allocate() {
+        if (!freeIds.empty()) {
+            int id = freeIds.back();
+            freeIds.pop_back();
+            return id;
+        }
+        int id = alive.size();
+        if (id >= points.rows()) {
+            points.conservativeResize(std::max<Eigen::Index>(16, 2 * points.rows()), Dim);
+        }
+        alive.push_back(0);
+        density.push_back(0);
+        raw.push_back(-1);
+        return id;
+    }
+
+    /**
+     * 点 i 的 Eps 邻域（不含自身）
+     */
+    std::vector<int> neighbors(int i) const {
+        std::vector<int> result;
+        double eps_sq = Eps * Eps;
+        Eigen::RowVectorXd p = points.row(i);
+        Grid.forEachNeighborCell(p, [&](const std::vector<int>& cell) {
+            for (int j : cell) {
+                if (j != i && (points.row(j) - p).squaredNorm() <= eps_sq) {
+                    result.push_back(j);
+                }
+            }
+        });
+        return result;
+    }
+
+    /**
+     * 非核心点所属的簇：若当前所在簇仍有相邻核心点则保留，否则取任一相邻核心点的簇（无则为 -1）
+     * @param i 点编号
+     * @param nb 点 i 的邻域
+     */
+    int borderCluster(int i, const std::vector<int>& nb) {
+        int current = label(i);
+        int any = -1;
+        for (int q : nb) {
+            if (!isCore(q)) continue;
+            int l = label(q);
+            if (l == current) return current;
+            if (any < 0) any = l;
+        }
+        return any;
+    }
+
+    int newCluster() {
+        clusterParent.push_back(clusterParent.size());
+        return clusterParent.size() - 1;
+    }
+
+    int findCluster(int c) {
+        while (clusterParent[c] != c) {
+            clusterParent[c] = clusterParent[clusterParent[c]];
+            c = clusterParent[c];
+        }
+        return c;
+    }
+
+    int mergeClusters(int a, int b) {
+        a = findCluster(a);
+        b = findCluster(b);
+        if (a == b) return a;
+        if (b < a) std::swap(a, b);
+        clusterParent[b] = a;
+        return a;
+    }
+
+    /**
+     * 检查簇 cluster 中的 seeds 在删除后是否仍经由核心点相连：
+     * 从每个起点同时（轮流各扩展一步）做 BFS，相遇的搜索合并为一组；当只剩一组仍在扩展时停止，
+     * 已经扩展完毕的组即为断开的部分，改用新的簇编号。代价只与断开部分的大小有关
+     * @param cluster 原簇编号
+     * @param seeds 该簇中需要检查的核心点
+     */
+    void splitCluster(int cluster, const std::vector<int>& seeds) {
+        int s = seeds.size();
+        DisjointSet group(s);
+        int groups = s;
+        std::unordered_map<int, int> owner;   // 已访问的核心点 -> 访问它的搜索
+        std::vector<std::deque<int>> queues(s);
+        for (int k = 0; k < s; ++k) {
+            owner.emplace(seeds[k], k);
+            queues[k].push_back(seeds[k]);
+        }
+
+        // 每组是否仍在扩展
+        auto activeGroups = [&]() {
+            std::vector<char> active(s, 0);
+            int n = 0;
+            for (int k = 0; k < s; ++k) {
+                int g = group.find(k);
+                if (!queues[k].empty() && !active[g]) {
+                    active[g] = 1;
+                    n++;
+                }
+            }
+            return n;
+        };
+
+        while (groups > 1 && activeGroups() > 1) {
+            for (int k = 0; k < s && groups > 1; ++k) {
+                if (queues[k].empty()) continue;
+                int u = queues[k].front();
+                queues[k].pop_front();
+                for (int v : neighbors(u)) {
+                    if (!isCore(v)) continue;
+                    auto it = owner.find(v);
+                    if (it == owner.end()) {
+                        owner.emplace(v, k);
+                        queues[k].push_back(v);
+                    } else if (group.unite(k, it->second) >= 0) {
+                        groups--;
+                    }
+                }
+            }
+        }
+        if (groups == 1) return;
+
+        // 仍在扩展的组（若有）保留原编号；全部扩展完毕时保留访问点最多的组
+        std::vector<int> visitedCount(s, 0);
+        for (const auto& kv : owner) visitedCount[group.find(kv.second)]++;
+        int keep = -1;
+        for (int k = 0; k < s; ++k) {
+            int g = group.find(k);
+            if (!queues[k].empty()) keep = g;
+        }
+        if (keep < 0) {
+            for (int k = 0; k < s; ++k) {
+                int g = group.find(k);
+                if (keep < 0 || visitedCount[g] > visitedCount[keep]) keep = g;
+            }
+        }
+
+        std::unordered_map<int, int> fresh;   // 断开的组 -> 新簇编号
+        for (const auto& kv : owner) {
+            int g = group.find(kv.second);
+            if (g == keep) continue;
+            auto it = fresh.find(g);
+            if (it == fresh.end()) it = fresh.emplace(g, newCluster()).first;
+            raw[kv.first] = it->second;
+        }
+        // 断开部分的边界点随相邻核心点迁移
+        for (const auto& kv : owner) {
+            if (group.find(kv.second) == keep) continue;
+            for (int q : neighbors(kv.first)) {
+                if (!isCore(q) && label(q) == cluster) raw[q] = raw[kv.first];
+            }
+        }
+    }
+};
+
+#endif // INCREMENTALDBSCAN_H
@@ -0,0 +1,171 @@
+#ifndef KDTREE_H
+#define KDTREE_H
+
+#include <vector>
+#include <Eigen/Dense>
+#include <algorithm>            // 提供 nth_element 等函数
+#include <queue>                // k 近邻查询的大顶堆
+#include <cmath>
+
+/**
+ * KDTree：对数据集按坐标轴递归二分的 kd 树
+ * 每个节点对应排列数组 perm 中的一段 [begin, end)，并缓存该段的包围盒和坐标和，
+ * 供 K-Means 过滤算法等按“整块单元”处理点集的算法使用
+ * @tparam Scalar 坐标存储类型（坐标和始终以 double 累加）
+ * @tparam Dim 数据维度（默认为动态维度）
+ */
+template <typename Scalar = double, int Dim = Eigen::Dynamic>
+class KDTree {
+public:
+    static constexpr int Layout = (Dim == 1) ? Eigen::ColMajor : Eigen::RowMajor;
+    using Matrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Dim, Layout>;  // 每行一个样本
+    using Point = Eigen::Matrix<Scalar, Dim, 1>;
+    using Sum = Eigen::Matrix<double, Dim, 1>;
+
+    /**
+     * Node：kd 树节点
+     */
+    struct Node {
+        int begin;              // 本节点包含的点在 perm 中的起始位置
+        int end;                // 本节点包含的点在 perm 中的结束位置（不含）
+        int left;               // 左子节点下标（叶子为 -1）
+        int right;              // 右子节点下标（叶子为 -1）
+        Point lo;               // 包围盒下界
+        Point hi;               // 包围盒上界
+        Sum sum;                // 节点内所有点的坐标和
+
+        bool isLeaf() const { return left < 0; }
+        int count() const { return end - begin; }
+    };
+
+    std::vector<Node> nodes;    // 所有节点（nodes[0] 为根）
+    std::vector<int> perm;      // 叶子顺序下的点索引排列
+
+    KDTree() {}
+
+    /**
+     * 构造函数：在数据集上建树
+     * @param data 数据矩阵（每行一个样本）
+     * @param leafsize 叶子节点最多包含的点数（默认为16）
+     */
+    explicit KDTree(const Matrix& data, int leafsize = 16)
+        : data_(data), leafSize_(std::max(1, leafsize)) {
+        perm.resize(data.rows());
+        for (int i = 0; i < data.rows(); ++i) {
+            perm[i] = i;
+        }
+        if (data.rows() > 0) {
+            build(0, data.rows());
+        }
+    }
+
+    const Matrix& data() const { return data_; }
+
+    /**
+     * 点 q 到节点包围盒的最小平方距离（q 在盒内时为 0）
+     * @param id 节点下标
+     * @param q 查询点
+     */
+    double boxDistanceSq(int id, const Point& q) const {
+        const Node& node = nodes[id];
+        double d = 0.0;
+        for (int j = 0; j < q.size(); ++j) {
+            double diff = 0.0;
+            if (q(j) < node.lo(j)) diff = double(node.lo(j)) - double(q(j));
+            else if (q(j) > node.hi(j)) diff = double(q(j)) - double(node.hi(j));
+            d += diff * diff;
+        }
+        return d;
+    }
+
+    /**
+     * k 近邻查询：先进入离 q 较近的子节点，包围盒距离不小于当前第 k 近距离的节点整体跳过
+     * @param q 查询点
+     * @param k 近邻个数（查询点本身在数据集中时也会被计入）
+     * @param indices 输出：近邻下标（按距离升序）
+     * @param distances 输出：对应的欧氏距离
+     */
+    void knnSearch(const Point& q, int k, std::vector<int>& indices, std::vector<double>& distances) const {
+        indices.clear();
+        distances.clear();
+        if (nodes.empty() || k <= 0) return;
+
+        std::priority_queue<std::pair<double, int>> heap; // (平方距离, 下标) 大顶堆
+        knnVisit(0, q, k, heap);
+
+        indices.resize(heap.size());
+        distances.resize(heap.size());
+        for (int i = heap.size() - 1; i >= 0; --i) {
+            indices[i] = heap.top().second;
+            distances[i] = std::sqrt(heap.top().first);
+            heap.pop();
+        }
+    }
+
+private:
+    Matrix data_;               // 建树用的数据
+    int leafSize_ = 16;         // 叶子节点最大点数
+
+    /**
+     * k 近邻查询的递归部分
+     */
+    void knnVisit(int id, const Point& q, int k, std::priority_queue<std::pair<double, int>>& heap) const {
+        const Node& node = nodes[id];
+        if (static_cast<int>(heap.size()) == k && boxDistanceSq(id, q) >= heap.top().first) return;
+
+        if (node.isLeaf()) {
+            for (int t = node.begin; t < node.end; ++t) {
+                int i = perm[t];
+                double d = (data_.row(i).transpose() - q).template cast<double>().squaredNorm();
+                if (static_cast<int>(heap.size()) < k) {
+                    heap.push(std::make_pair(d, i));
+                } else if (d < heap.top().first) {
+                    heap.pop();
+                    heap.push(std::make_pair(d, i));
+                }
+            }
+            return;
+        }
+
+        int first = node.left, second = node.right;
+        if (boxDistanceSq(second, q) < boxDistanceSq(first, q)) std::swap(first, second);
+        knnVisit(first, q, k, heap);
+        knnVisit(second, q, k, heap);
+    }
+
+    /**
+     * 递归建树：沿包围盒最宽的维度在中位数处切分
+     * @return 新节点下标
+     */
+    int build(int begin, int end) {
+        int id = nodes.size();
+        nodes.resize(id + 1);
+
+        Matrix pts = data_(std::vector<int>(perm.begin() + begin, perm.begin() + end), Eigen::all);
+        Node node;
+        node.begin = begin;
+        node.end = end;
+        node.left = -1;
+        node.right = -1;
+        node.lo = pts.colwise().minCoeff().transpose();
+        node.hi = pts.colwise().maxCoeff().transpose();
+        node.sum = pts.template cast<double>().colwise().sum().transpose();
+
+        if (end - begin > leafSize_) {
+            int dim;
+            (node.hi - node.lo).maxCoeff(&dim);
+
+            int mid = begin + (end - begin) / 2;
+            std::nth_element(perm.begin() + begin, perm.begin() + mid, perm.begin() + end,
+                             [&](int a, int b) { return data_(a, dim) < data_(b, dim); });
+
+            node.left = build(begin, mid);
+            node.right = build(mid, end);
+        }
+
+        nodes[id] = node;
+        return id;
+    }
+};
+
+#endif // KDTREE_H
@@ -7,17 +7,69 @@
 #include <Eigen/StdVector>
 #include <algorithm>            // 提供 shuffle 等函数
 #include <random>               // 用于随机数生成
+#include <limits>               // 提供 numeric_limits（距离上下界初值）
+#include <numeric>              // 提供 iota（二分 K-Means 的初始簇）
+#include "KDTree.h"             // kd 树（过滤算法引擎使用）
+
+/**
+ * KMeansEngine：K-Means 每轮“分配 + 更新中心”所使用的计算方式
+ */
+enum KMeansEngine {
+    LloydEngine,    // 经典 Lloyd 迭代：每轮计算完整的 N × K 距离矩阵
+    ElkanEngine,    // Elkan 加速：每个点维护 1 个上界和 K 个下界，利用中心间距离跳过大部分距离计算
+    HamerlyEngine,  // Hamerly 加速：每个点只维护 1 个上界和 1 个下界，内存 O(N)，适合 K 较小的情况
+    MiniBatchEngine,// Mini-batch：每轮只用随机抽取的一批样本更新中心，适合超大数据集
+    KdTreeEngine,   // kd 树过滤（Kanungo 等）：整块单元与候选中心比较并剪枝，适合低维数据
+    BisectingEngine // 二分 K-Means：反复用 2-means 分裂 SSE 最大的簇直到 K 个，每层只需 O(N)，适合 K 很大的情况
+};
+
+/**
+ * KMeansInit：K-Means 初始中心的选取方式
+ */
+enum KMeansInit {
+    RandomInit,     // 随机打乱后取前 K 个样本
+    PlusPlusInit,   // k-means++：按到已选中心的距离平方 D² 依次加权抽样
+    ParallelInit    // k-means||：每轮按 D² 并行过采样约 2K 个候选点，再在加权候选集上做 k-means++
+};
 
 /**
  * K_Means：实现经典的 K-Means 聚类算法（基于迭代优化）
+ * @tparam Scalar 数据与中心的存储类型（double / float），坐标和始终以 double 累加
+ * @tparam Dim 数据维度，固定维度（如 2）时距离计算可展开并向量化，默认为动态维度
  */
+template <typename Scalar = double, int Dim = Eigen::Dynamic>
 class K_Means {
+public:
+    // 样本 / 中心矩阵按行存储，使每个点的坐标在内存中连续（单列时 Eigen 要求列存储）
+    static constexpr int Layout = (Dim == 1) ? Eigen::ColMajor : Eigen::RowMajor;
+    using Matrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Dim, Layout>;          // 每行一个样本或中心
+    using AccMatrix = Eigen::Matrix<double, Eigen::Dynamic, Dim, Layout>;       // 中心坐标和（double 累加）
+    using DistMatrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>; // N × K 距离矩阵
+    using BoundMatrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;  // 下界 / 中心间距离
+    using Vector = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
+    using RowVector = Eigen::Matrix<Scalar, 1, Dim>;
+    using Point = Eigen::Matrix<Scalar, Dim, 1>;
+    using Tree_t = KDTree<Scalar, Dim>;
+
 private:
     int K;                      // 要聚类的数量（簇数）
     int Maxiter;                // 最大迭代次数
     double tol;                 // 收敛阈值（中心变化小于该值则停止）
-    Eigen::MatrixXd X;          // 输入数据集（每行一个样本）
-    Eigen::MatrixXd Center;     // 聚类中心矩阵（K × D）
+    Matrix X;                   // 输入数据集（每行一个样本）
+    Matrix Center;              // 聚类中心矩阵（K × D）
+    KMeansEngine Engine;        // 迭代引擎（Lloyd / Elkan / Hamerly / MiniBatch / KdTree / Bisecting）
+    Tree_t Tree;                // kd 树（仅 KdTree 引擎使用，每次 start 只建一次）
+    int BatchSize;              // Mini-batch 每批样本数
+    int HistoryStep;            // Mini-batch 每隔多少批（二分 K-Means 每隔多少次分裂）记录一次历史
+    KMeansInit InitMethod;      // 初始中心选取方式
+    bool Warm = false;          // 是否已由 warmStart 给定中心、标签与上下界（第 0 轮不再全量初始化）
+
+    // 三角不等式加速所需的状态（仅 Elkan / Hamerly 使用）
+    Vector Upper;               // 每个点到其所属中心距离的上界（N）
+    BoundMatrix Lower;          // 下界（每列一个样本）：Elkan 为 K × N（到每个中心），Hamerly 为 1 × N（到次近中心）
+    BoundMatrix CenterDist;     // 中心两两之间的距离（K × K）
+    Vector HalfMinDist;         // 每个中心到最近其它中心距离的一半 s(c)（K）
+    Vector Shift;               // 最近一次更新中每个中心移动的距离（K）
 
 public:
     std::vector<int> labels;                    // 每个样本对应的聚类标签
@@ -29,7 +81,7 @@ public:
      * 构造函数（无参数构造函数）
      * @param x 输入数据矩阵（每行一个样本）
      */
-    K_Means(Eigen::MatrixXd x) : X(x) {}
+    K_Means(Eigen::MatrixXd x) : X(x.template cast<Scalar>()) {}
 
     /**
      * 构造函数（带参数构造函数）
@@ -37,26 +89,44 @@ public:
      * @param x 输入数据矩阵
      * @param maxiter 最大迭代次数（默认为20）
      * @param tor 收敛容忍度（默认为1e-6）
+     * @param engine 迭代引擎（默认为 Lloyd）
+     * @param batchsize Mini-batch 每批样本数（默认为1024，仅 MiniBatch 引擎使用）
+     * @param historystep Mini-batch 每隔多少批、二分 K-Means 每隔多少次分裂记录一次历史（默认为10）
+     * @param init 初始中心选取方式（默认为随机选取）
      */
-    K_Means(int k, Eigen::MatrixXd x, int maxiter = 20, double tor = 1e-6)
-        : K(k), X(x), Maxiter(maxiter), tol(tor) {
-        Center = Eigen::MatrixXd(K, x.cols()); // 初始化中心矩阵
+    K_Means(int k, Eigen::MatrixXd x, int maxiter = 20, double tor = 1e-6, KMeansEngine engine = LloydEngine,
+            int batchsize = 1024, int historystep = 10, KMeansInit init = RandomInit)
+        : K(k), Maxiter(maxiter), tol(tor), X(x.template cast<Scalar>()), Engine(engine),
+          BatchSize(batchsize), HistoryStep(std::max(1, historystep)), InitMethod(init) {
+        Center = Matrix(K, x.cols());           // 初始化中心矩阵
         labels = std::vector<int>(x.rows());    // 初始化标签
-        Init();                                 // 初始化聚类中心
+        if (Engine != BisectingEngine) {
+            Init();                             // 初始化聚类中心（二分 K-Means 由分裂过程产生中心）
+        }
     }
 
     /**
-     * 初始化聚类中心：从数据中随机选取 K 个点作为初始中心
+     * 初始化聚类中心：按 InitMethod 选取 K 个初始中心
      */
     void Init() {
+        std::random_device rd;
+        std::mt19937 gen(rd());
+
+        if (InitMethod == PlusPlusInit) {
+            Center = plusPlus(X, Eigen::VectorXd::Ones(X.rows()), K, gen);
+            return;
+        }
+        if (InitMethod == ParallelInit) {
+            initParallel(gen);
+            return;
+        }
+
         std::vector<int> indices(X.rows());
         for (int i = 0; i < X.rows(); ++i) {
             indices[i] = i;
         }
 
         // 使用随机引擎打乱索引
-        std::random_device rd;
-        std::mt19937 gen(rd());
         std::shuffle(indices.begin(), indices.end(), gen);
 
         // 选取前 K 个点作为初始中心
@@ -65,48 +135,316 @@ public:
         }
     }
 
+    /**
+     * 热启动（增量模式）：以上一次的中心作为初始中心，沿用未变动样本的标签与 Hamerly 上下界，
+     * 只对新增样本计算到所有中心的距离；之后按 Hamerly 迭代，界仍成立的样本整点跳过
+     * @param center 上一次的聚类中心（K × D）
+     * @param prevLabels 每个样本沿用的标签（新增样本为 -1）
+     * @param upper 每个样本沿用的上界（新增样本处的值被忽略）
+     * @param lower 每个样本沿用的下界（新增样本处的值被忽略）
+     */
+    void warmStart(const Eigen::MatrixXd& center, const std::vector<int>& prevLabels,
+                   const Eigen::VectorXd& upper, const Eigen::VectorXd& lower) {
+        Engine = HamerlyEngine;
+        Center = center.template cast<Scalar>();
+        Upper = upper.template cast<Scalar>();
+        Lower = lower.transpose().template cast<Scalar>();
+        labels = prevLabels;
+
+        #pragma omp parallel for schedule(dynamic, 256)
+        for (int i = 0; i < X.rows(); ++i) {
+            if (labels[i] >= 0) continue;
+
+            Scalar best = std::numeric_limits<Scalar>::infinity();
+            Scalar second = std::numeric_limits<Scalar>::infinity();
+            for (int k = 0; k < K; ++k) {
+                Scalar d = (X.row(i) - Center.row(k)).norm();
+                if (d < best) {
+                    second = best;
+                    best = d;
+                    labels[i] = k;
+                } else if (d < second) {
+                    second = d;
+                }
+            }
+            Upper(i) = best;
+            Lower(0, i) = second;
+        }
+        Warm = true;
+    }
+
+    /**
+     * 由较小 K 的结果热启动（K 扫描使用）：沿用 prev 的中心，再按到最近中心的距离平方 D² 依次抽样补足其余中心，
+     * 之后仍按所选引擎迭代。Hamerly 引擎另外沿用 prev 的标签与上下界（下界与到新中心的距离取较小值）；
+     * 其它引擎只以这些中心作为初始中心，第 0 轮照常全量分配，扫描中每个 K 都由同一种算法得到
+     * @param prev 同一数据集上 K 更小的已完成聚类
+     * @param gen 随机数引擎
+     */
+    void warmStartFrom(const K_Means& prev, std::mt19937& gen) {
+        bool bounds = Engine == HamerlyEngine;
+        Eigen::VectorXd upper, lower;
+        if (bounds) {
+            prev.exportBounds(upper, lower);
+        }
+
+        Eigen::MatrixXd C(K, X.cols());
+        C.topRows(prev.K) = prev.centerMatrix();
+        Eigen::VectorXd d2(X.rows());
+        for (int i = 0; i < X.rows(); ++i) {
+            d2(i) = (prev.X.row(i) - prev.Center.row(prev.labels[i])).squaredNorm();
+        }
+
+        for (int k = prev.K; k < K; ++k) {
+            C.row(k) = X.row(sampleByWeight(d2, gen)).template cast<double>();
+            #pragma omp parallel for schedule(static)
+            for (int i = 0; i < X.rows(); ++i) {
+                double d = (X.row(i).template cast<double>() - C.row(k)).norm();
+                d2(i) = std::min(d2(i), d * d);
+                if (bounds) lower(i) = std::min(lower(i), d);
+            }
+        }
+
+        if (bounds) {
+            warmStart(C, prev.labels, upper, lower);
+        } else {
+            Center = C.template cast<Scalar>();
+        }
+    }
+
+    /**
+     * 导出 Hamerly 形式的上下界（到所属中心距离的上界、到其它中心距离的下界），供下一次热启动使用；
+     * 没有维护上下界的引擎（Lloyd / MiniBatch / KdTree）按最终中心精确计算一次
+     * @param upper 输出：每个样本的上界
+     * @param lower 输出：每个样本的下界
+     */
+    void exportBounds(Eigen::VectorXd& upper, Eigen::VectorXd& lower) const {
+        upper = Eigen::VectorXd(X.rows());
+        lower = Eigen::VectorXd(X.rows());
+        bool hasBounds = (Engine == ElkanEngine || Engine == HamerlyEngine) && Upper.size() == X.rows();
+
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < X.rows(); ++i) {
+            int a = labels[i];
+            if (hasBounds) {
+                upper(i) = Upper(i);
+                if (Engine == HamerlyEngine) {
+                    lower(i) = Lower(0, i);
+                } else {
+                    Scalar second = std::numeric_limits<Scalar>::infinity();
+                    for (int k = 0; k < K; ++k) {
+                        if (k != a) second = std::min(second, Lower(k, i));
+                    }
+                    lower(i) = second;
+                }
+                continue;
+            }
+
+            Scalar second = std::numeric_limits<Scalar>::infinity();
+            for (int k = 0; k < K; ++k) {
+                if (k != a) second = std::min(second, Scalar((X.row(i) - Center.row(k)).norm()));
+            }
+            upper(i) = (X.row(i) - Center.row(a)).norm();
+            lower(i) = second;
+        }
+    }
+
+    /**
+     * 获取当前中心（K × D，double）
+     */
+    Eigen::MatrixXd centerMatrix() const {
+        return Center.template cast<double>();
+    }
+
+    /**
+     * 按权重抽取一个下标（权重全为 0 时退化为均匀抽样）
+     * @param weight 非负权重向量
+     * @param gen 随机数引擎
+     * @return 被抽中的下标
+     */
+    static int sampleByWeight(const Eigen::VectorXd& weight, std::mt19937& gen) {
+        double total = weight.sum();
+        if (!(total > 0)) {
+            std::uniform_int_distribution<int> pick(0, weight.size() - 1);
+            return pick(gen);
+        }
+
+        std::uniform_real_distribution<double> dist(0.0, total);
+        double r = dist(gen);
+        double acc = 0.0;
+        for (int i = 0; i < weight.size(); ++i) {
+            acc += weight(i);
+            if (r < acc) return i;
+        }
+        return weight.size() - 1;
+    }
+
+    /**
+     * 加权 k-means++：第一个中心按权重抽取，之后每个中心按 权重 × D² 抽取，
+     * D²（到最近已选中心的距离平方）对整个 P 向量化更新
+     * @param P 候选点（每行一个）
+     * @param weight 每个候选点的权重
+     * @param k 需要选出的中心数
+     * @param gen 随机数引擎
+     * @return 选出的中心矩阵（k × D）
+     */
+    static Matrix plusPlus(const Matrix& P, const Eigen::VectorXd& weight, int k, std::mt19937& gen) {
+        Matrix C(k, P.cols());
+        C.row(0) = P.row(sampleByWeight(weight, gen));
+
+        Eigen::VectorXd D2 = (P.rowwise() - C.row(0)).rowwise().squaredNorm().template cast<double>();
+        for (int c = 1; c < k; ++c) {
+            C.row(c) = P.row(sampleByWeight(weight.cwiseProduct(D2), gen));
+            D2 = D2.cwiseMin((P.rowwise() - C.row(c)).rowwise().squaredNorm().template cast<double>());
+        }
+        return C;
+    }
+
+    /**
+     * k-means|| 初始化：
+     * 1. 随机选 1 个点，计算全体 D² 与总代价 φ
+     * 2. 进行若干轮，每个点以 min(1, l·D²/φ) 的概率独立入选（l = 2K），并用新候选更新 D²
+     * 3. 每个候选点以“离它最近的样本数”为权重，在候选集上做加权 k-means++ 选出 K 个中心
+     * @param gen 随机数引擎
+     */
+    void initParallel(std::mt19937& gen) {
+        const int rounds = 5;
+        const double l = 2.0 * K;
+        std::uniform_int_distribution<int> pick(0, X.rows() - 1);
+        std::uniform_real_distribution<double> coin(0.0, 1.0);
+
+        std::vector<int> chosen = {pick(gen)};
+        Eigen::VectorXd D2 = (X.rowwise() - X.row(chosen[0])).rowwise().squaredNorm().template cast<double>();
+        Vector X_norms = X.rowwise().squaredNorm();
+
+        for (int round = 0; round < rounds; ++round) {
+            double phi = D2.sum();
+            if (!(phi > 0)) break;
+
+            // 独立抽样：各点互不依赖，可整体并行
+            std::vector<int> sampled;
+            for (int i = 0; i < X.rows(); ++i) {
+                if (coin(gen) < l * D2(i) / phi) sampled.push_back(i);
+            }
+            if (sampled.empty()) continue;
+
+            // 一次矩阵运算求出所有点到本轮新候选的最小距离平方
+            Matrix S = X(sampled, Eigen::all);
+            DistMatrix dists_sq = (Scalar(-2) * (X * S.transpose())).rowwise() + S.rowwise().squaredNorm().transpose();
+            dists_sq = dists_sq.colwise() + X_norms;
+            D2 = D2.cwiseMin(dists_sq.rowwise().minCoeff().cwiseMax(Scalar(0)).template cast<double>());
+            chosen.insert(chosen.end(), sampled.begin(), sampled.end());
+        }
+
+        // 候选点不足 K 个时退回到普通 k-means++
+        if (static_cast<int>(chosen.size()) < K) {
+            Center = plusPlus(X, Eigen::VectorXd::Ones(X.rows()), K, gen);
+            return;
+        }
+
+        // 统计每个候选点作为最近候选的样本数，作为权重
+        Matrix Candidates = X(chosen, Eigen::all);
+        Eigen::VectorXd weight = Eigen::VectorXd::Zero(Candidates.rows());
+        for (int i = 0; i < X.rows(); ++i) {
+            int index;
+            (Candidates.rowwise() - X.row(i)).rowwise().squaredNorm().minCoeff(&index);
+            weight(index) += 1.0;
+        }
+
+        Center = plusPlus(Candidates, weight, K, gen);
+    }
+
     /**
      * 计算每个样本到各个聚类中心的欧氏距离
      * @return 距离矩阵（N × K），每行表示样本到各中心的距离
      */
-    Eigen::MatrixXd distance() {
+    DistMatrix distance() {
         // 计算输入样本的平方 L2 范数（每行一个样本）
-        Eigen::VectorXd X_norms = X.rowwise().squaredNorm();
+        Vector X_norms = X.rowwise().squaredNorm();
 
         // 计算聚类中心的平方 L2 范数（每行一个中心）
-        Eigen::VectorXd C_norms = Center.rowwise().squaredNorm();
+        Vector C_norms = Center.rowwise().squaredNorm();
 
         // 计算点积矩阵：X * Center^T （N × K）
-        Eigen::MatrixXd dot_products = X * Center.transpose();
+        DistMatrix dot_products = X * Center.transpose();
 
         // 利用公式计算距离平方：||x_i - c_j||^2 = ||x_i||^2 + ||c_j||^2 - 2*x_i*c_j^T
-        Eigen::MatrixXd dists_sq = (-2 * dot_products).rowwise() + C_norms.transpose();
+        DistMatrix dists_sq = (Scalar(-2) * dot_products).rowwise() + C_norms.transpose();
         dists_sq = dists_sq.colwise() + X_norms;
 
         // 返回开根号后的欧氏距离矩阵
-        return dists_sq.cwiseMax(0).array().sqrt();
+        return dists_sq.cwiseMax(Scalar(0)).array().sqrt();
     }
 
     /**
-     * 更新聚类标签与中心
+     * 更新聚类标签与中心（多线程：各线程在本地累加中心和与计数，最后合并）
      * @param dists 各样本到各聚类中心的距离矩阵
      * @return 是否收敛（即中心变化小于 tol）
      */
-    bool update(Eigen::MatrixXd dists) {
-        Eigen::MatrixXd NewCenter = Eigen::MatrixXd(K, X.cols());
-        std::vector<int> counts(K, 0); 
+    bool update(const DistMatrix& dists) {
+        AccMatrix NewCenter = AccMatrix::Zero(K, X.cols());
+        std::vector<int> counts(K, 0);
 
-        NewCenter.setZero(); 
+        #pragma omp parallel
+        {
+            AccMatrix localSum = AccMatrix::Zero(K, X.cols());
+            std::vector<int> localCount(K, 0);
 
-        // 分配每个样本到最近的聚类中心
-        for (int i = 0; i < X.rows(); ++i) {
-            int index;
-            dists.row(i).minCoeff(&index); // 找到最近的中心索引
-            labels[i] = index;             // 分配标签
-            NewCenter.row(index) += X.row(i);
-            counts[index]++;
+            // 分配每个样本到最近的聚类中心
+            #pragma omp for schedule(static)
+            for (int i = 0; i < X.rows(); ++i) {
+                int index;
+                dists.row(i).minCoeff(&index); // 找到最近的中心索引
+                labels[i] = index;             // 分配标签
+                localSum.row(index) += X.row(i).template cast<double>();
+                localCount[index]++;
+            }
+
+            #pragma omp critical
+            {
+                NewCenter += localSum;
+                for (int k = 0; k < K; ++k) counts[k] += localCount[k];
+            }
         }
 
+        return applyCenters(NewCenter, counts);
+    }
+
+    /**
+     * 根据当前标签重新计算聚类中心（多线程累加）
+     * @return 是否收敛（即中心变化小于 tol）
+     */
+    bool moveCenters() {
+        AccMatrix NewCenter = AccMatrix::Zero(K, X.cols());
+        std::vector<int> counts(K, 0);
+
+        #pragma omp parallel
+        {
+            AccMatrix localSum = AccMatrix::Zero(K, X.cols());
+            std::vector<int> localCount(K, 0);
+
+            #pragma omp for schedule(static)
+            for (int i = 0; i < X.rows(); ++i) {
+                localSum.row(labels[i]) += X.row(i).template cast<double>();
+                localCount[labels[i]]++;
+            }
+
+            #pragma omp critical
+            {
+                NewCenter += localSum;
+                for (int k = 0; k < K; ++k) counts[k] += localCount[k];
+            }
+        }
+
+        return applyCenters(NewCenter, counts);
+    }
+
+    /**
+     * 由各簇的坐标和与样本数得到新中心，判断收敛并记录每个中心的移动距离
+     * @param NewCenter 各簇样本坐标之和（K × D），函数内就地取平均
+     * @param counts 各簇样本数
+     * @return 是否收敛（即中心变化小于 tol）
+     */
+    bool applyCenters(AccMatrix& NewCenter, const std::vector<int>& counts) {
         // 更新每个聚类中心（取平均）
         for (int k = 0; k < K; ++k) {
             if (counts[k] > 0) { 
@@ -114,15 +452,467 @@ public:
             }
         }
 
+        // 先转换为存储精度再比较，避免 float 舍入误差导致永不收敛
+        Matrix Moved = NewCenter.template cast<Scalar>();
+
         // 判断是否收敛
-        if (((NewCenter - Center).cwiseAbs().array() < tol).all()) {
+        if (((Moved - Center).cwiseAbs().array() < Scalar(tol)).all()) {
             return true;
         } else {
-            Center = NewCenter; // 更新中心
+            Shift = (Moved - Center).rowwise().norm();
+            Center = Moved; // 更新中心
             return false;
         }
     }
 
+    /**
+     * 计算中心两两之间的距离，以及每个中心到最近其它中心距离的一半
+     */
+    void centerDistance() {
+        CenterDist = BoundMatrix::Zero(K, K);
+        HalfMinDist = Vector::Constant(K, std::numeric_limits<Scalar>::infinity());
+        for (int a = 0; a < K; ++a) {
+            for (int b = a + 1; b < K; ++b) {
+                Scalar d = (Center.row(a) - Center.row(b)).norm();
+                CenterDist(a, b) = d;
+                CenterDist(b, a) = d;
+                HalfMinDist(a) = std::min(HalfMinDist(a), Scalar(0.5) * d);
+                HalfMinDist(b) = std::min(HalfMinDist(b), Scalar(0.5) * d);
+            }
+        }
+    }
+
+    /**
+     * 第一轮：计算完整距离矩阵完成分配，并据此初始化上下界
+     */
+    void initBounds() {
+        DistMatrix dists = distance();
+        Upper = Vector(X.rows());
+        Lower = BoundMatrix(Engine == ElkanEngine ? K : 1, X.rows());
+
+        for (int i = 0; i < X.rows(); ++i) {
+            int index;
+            Upper(i) = dists.row(i).minCoeff(&index);
+            labels[i] = index;
+
+            if (Engine == ElkanEngine) {
+                Lower.col(i) = dists.row(i).transpose();
+            } else {
+                // Hamerly 只保存到次近中心的距离
+                Scalar second = std::numeric_limits<Scalar>::infinity();
+                for (int k = 0; k < K; ++k) {
+                    if (k != index) second = std::min(second, dists(i, k));
+                }
+                Lower(0, i) = second;
+            }
+        }
+    }
+
+    /**
+     * Elkan 分配：利用上界、K 个下界和中心间距离跳过不可能改变归属的距离计算
+     */
+    void assignElkan() {
+        centerDistance();
+
+        #pragma omp parallel for schedule(dynamic, 256)
+        for (int i = 0; i < X.rows(); ++i) {
+            int a = labels[i];
+            if (Upper(i) <= HalfMinDist(a)) continue; // 该点不可能换中心
+
+            bool tight = false; // 上界是否已是精确距离
+            for (int k = 0; k < K; ++k) {
+                if (k == a) continue;
+                if (Upper(i) <= Lower(k, i) || Upper(i) <= 0.5 * CenterDist(a, k)) continue;
+
+                if (!tight) {
+                    Upper(i) = (X.row(i) - Center.row(a)).norm();
+                    Lower(a, i) = Upper(i);
+                    tight = true;
+                    if (Upper(i) <= Lower(k, i) || Upper(i) <= 0.5 * CenterDist(a, k)) continue;
+                }
+
+                Scalar d = (X.row(i) - Center.row(k)).norm();
+                Lower(k, i) = d;
+                if (d < Upper(i)) {
+                    a = k;
+                    Upper(i) = d;
+                }
+            }
+            labels[i] = a;
+        }
+    }
+
+    /**
+     * Hamerly 分配：每个点只用一个下界，上界不超过 max(下界, s(c)) 时整点跳过
+     */
+    void assignHamerly() {
+        centerDistance();
+
+        #pragma omp parallel for schedule(dynamic, 256)
+        for (int i = 0; i < X.rows(); ++i) {
+            int a = labels[i];
+            Scalar bound = std::max(HalfMinDist(a), Lower(0, i));
+            if (Upper(i) <= bound) continue;
+
+            Upper(i) = (X.row(i) - Center.row(a)).norm(); // 收紧上界后再判断一次
+            if (Upper(i) <= bound) continue;
+
+            // 无法排除，重新计算到所有中心的距离（找最近和次近）
+            Scalar best = std::numeric_limits<Scalar>::infinity();
+            Scalar second = std::numeric_limits<Scalar>::infinity();
+            int index = a;
+            for (int k = 0; k < K; ++k) {
+                Scalar d = (X.row(i) - Center.row(k)).norm();
+                if (d < best) {
+                    second = best;
+                    best = d;
+                    index = k;
+                } else if (d < second) {
+                    second = d;
+                }
+            }
+            labels[i] = index;
+            Upper(i) = best;
+            Lower(0, i) = second;
+        }
+    }
+
+    /**
+     * 中心移动后修正上下界：上界增加所属中心的位移，下界减去相应中心的位移
+     */
+    void updateBounds() {
+        if (Engine == ElkanEngine) {
+            #pragma omp parallel for schedule(static)
+            for (int i = 0; i < X.rows(); ++i) {
+                Upper(i) += Shift(labels[i]);
+                Lower.col(i) = (Lower.col(i) - Shift).cwiseMax(Scalar(0));
+            }
+        } else {
+            // 下界需减去“除所属中心外”的最大位移
+            int first;
+            Scalar max_shift = Shift.maxCoeff(&first);
+            Scalar second_shift = 0;
+            for (int k = 0; k < K; ++k) {
+                if (k != first) second_shift = std::max(second_shift, Shift(k));
+            }
+            #pragma omp parallel for schedule(static)
+            for (int i = 0; i < X.rows(); ++i) {
+                Upper(i) += Shift(labels[i]);
+                Lower(0, i) -= (labels[i] == first) ? second_shift : max_shift;
+            }
+        }
+    }
+
+    /**
+     * 判断候选中心 z 能否被 best 剪枝：取包围盒上沿 (z - best) 方向最远的顶点 v，
+     * 若 v 到 best 不比到 z 远，则盒内任何点都不会更靠近 z
+     * @param z 待检查的候选中心下标
+     * @param best 离单元中点最近的候选中心下标
+     * @param node kd 树节点
+     * @return z 是否可以从候选集中剔除
+     */
+    bool isFarther(int z, int best, const typename Tree_t::Node& node) const {
+        Point u = (Center.row(z) - Center.row(best)).transpose();
+        Point v = (u.array() > Scalar(0)).select(node.hi, node.lo);
+        return (Center.row(z).transpose() - v).squaredNorm() >= (Center.row(best).transpose() - v).squaredNorm();
+    }
+
+    /**
+     * kd 树过滤：候选中心只剩一个时，整块单元的坐标和与点数一次性归入该中心；
+     * 否则剪枝后递归到子节点，叶子节点再逐点比较剩余候选
+     * @param id 当前节点下标
+     * @param candidates 当前候选中心
+     * @param sums 各中心的坐标和（累加）
+     * @param counts 各中心的样本数（累加）
+     */
+    void filter(int id, const std::vector<int>& candidates, AccMatrix& sums, std::vector<int>& counts) {
+        const typename Tree_t::Node& node = Tree.nodes[id];
+
+        if (node.isLeaf()) {
+            for (int p = node.begin; p < node.end; ++p) {
+                int i = Tree.perm[p];
+                int best = candidates[0];
+                Scalar best_d = (X.row(i) - Center.row(best)).squaredNorm();
+                for (size_t c = 1; c < candidates.size(); ++c) {
+                    Scalar d = (X.row(i) - Center.row(candidates[c])).squaredNorm();
+                    if (d < best_d) {
+                        best_d = d;
+                        best = candidates[c];
+                    }
+                }
+                labels[i] = best;
+                sums.row(best) += X.row(i).template cast<double>();
+                counts[best]++;
+            }
+            return;
+        }
+
+        // 找到离单元中点最近的候选中心
+        RowVector mid = (Scalar(0.5) * (node.lo + node.hi)).transpose();
+        int best = candidates[0];
+        Scalar best_d = (Center.row(best) - mid).squaredNorm();
+        for (size_t c = 1; c < candidates.size(); ++c) {
+            Scalar d = (Center.row(candidates[c]) - mid).squaredNorm();
+            if (d < best_d) {
+                best_d = d;
+                best = candidates[c];
+            }
+        }
+
+        std::vector<int> kept;
+        for (int z : candidates) {
+            if (z == best || !isFarther(z, best, node)) kept.push_back(z);
+        }
+
+        if (kept.size() == 1) {
+            // 整个单元都归属 best，无需逐点计算距离
+            sums.row(best) += node.sum.transpose();
+            counts[best] += node.count();
+            for (int p = node.begin; p < node.end; ++p) {
+                labels[Tree.perm[p]] = best;
+            }
+            return;
+        }
+
+        filter(node.left, kept, sums, counts);
+        filter(node.right, kept, sums, counts);
+    }
+
+    /**
+     * kd 树引擎的一轮迭代：从根节点开始过滤，再由累加结果更新中心
+     * @return 是否收敛
+     */
+    bool filterStep() {
+        AccMatrix NewCenter = AccMatrix::Zero(K, X.cols());
+        std::vector<int> counts(K, 0);
+
+        std::vector<int> candidates(K);
+        for (int k = 0; k < K; ++k) {
+            candidates[k] = k;
+        }
+        filter(0, candidates, NewCenter, counts);
+
+        return applyCenters(NewCenter, counts);
+    }
+
+    /**
+     * 执行一轮迭代：按所选引擎完成分配，再更新中心
+     * @param iter 当前迭代轮次（加速引擎在第 0 轮初始化上下界，热启动时沿用已有上下界）
+     * @return 是否收敛
+     */
+    bool step(int iter) {
+        if (Engine == LloydEngine) {
+            return update(distance());
+        }
+        if (Engine == KdTreeEngine) {
+            if (iter == 0) {
+                Tree = Tree_t(X); // 只在第一轮建树
+            }
+            return filterStep();
+        }
+
+        if (iter == 0 && !Warm) {
+            initBounds();
+        } else if (Engine == ElkanEngine) {
+            assignElkan();
+        } else {
+            assignHamerly();
+        }
+
+        if (moveCenters()) {
+            return true;
+        }
+        updateBounds();
+        return false;
+    }
+
+    /**
+     * 不构建 N × K 距离矩阵，逐点把所有样本分配到最近的中心
+     */
+    void assignAll() {
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < X.rows(); ++i) {
+            int index;
+            (Center.rowwise() - X.row(i)).rowwise().squaredNorm().minCoeff(&index);
+            labels[i] = index;
+        }
+    }
+
+    /**
+     * Mini-batch 更新：每批随机抽取 BatchSize 个样本，先按当前中心分配，
+     * 再以 1 / (该中心累计样本数) 为学习率把中心向样本方向移动
+     * @param counts 每个中心至今累计分到的样本数（跨批次保留）
+     * @param gen 随机数引擎
+     * @return 是否收敛（本批中心变化小于 tol）
+     */
+    bool miniBatchStep(std::vector<long long>& counts, std::mt19937& gen) {
+        int n = X.rows();
+        int b = std::min(BatchSize, n);
+        std::uniform_int_distribution<int> pick(0, n - 1);
+
+        std::vector<int> batch(b);
+        for (int j = 0; j < b; ++j) {
+            batch[j] = pick(gen);
+        }
+
+        // 先用本批开始时的中心完成分配
+        Matrix Xb = X(batch, Eigen::all);
+        Vector C_norms = Center.rowwise().squaredNorm();
+        DistMatrix dists_sq = (Scalar(-2) * (Xb * Center.transpose())).rowwise() + C_norms.transpose();
+
+        std::vector<int> assign(b);
+        for (int j = 0; j < b; ++j) {
+            dists_sq.row(j).minCoeff(&assign[j]);
+        }
+
+        // 逐个样本做带学习率的中心更新
+        Matrix OldCenter = Center;
+        for (int j = 0; j < b; ++j) {
+            int c = assign[j];
+            counts[c]++;
+            Scalar eta = Scalar(1) / static_cast<Scalar>(counts[c]);
+            Center.row(c) = (Scalar(1) - eta) * Center.row(c) + eta * X.row(batch[j]);
+        }
+
+        return ((Center - OldCenter).cwiseAbs().array() < Scalar(tol)).all();
+    }
+
+    /**
+     * Mini-batch K-Means 主流程：Maxiter 表示批次数，每 HistoryStep 批做一次全量分配并记录历史，最终结果总是最后一帧
+     */
+    void startMiniBatch() {
+        std::random_device rd;
+        std::mt19937 gen(rd());
+        std::vector<long long> counts(K, 0);
+
+        bool recorded = false;      // 最后执行的一批之后是否已记录（此时最终状态即最后一帧）
+        for (int i = 0; i < Maxiter; ++i) {
+            bool converged = miniBatchStep(counts, gen);
+
+            recorded = (i + 1) % HistoryStep == 0;
+            if (recorded) {
+                assignAll();
+                label_history.push_back(labels);
+                get_center();
+                center_history.push_back(centers);
+            }
+
+            if (converged) {
+                break;
+            }
+        }
+
+        // 以最终中心给全部样本分配标签；最后一批不在记录步长上时补记一帧，动画总以最终结果结束
+        assignAll();
+        get_center();
+        if (!recorded) {
+            label_history.push_back(labels);
+            center_history.push_back(centers);
+        }
+    }
+
+    /**
+     * 用 2-means 把一个簇一分为二（k-means++ 初始化，Lloyd 迭代）
+     * @param idx 簇内样本下标
+     * @param left 输出：第一个子簇的样本下标
+     * @param right 输出：第二个子簇的样本下标
+     * @param centroid 输出：两个子簇的中心（2 × D）
+     * @param sse 输出：两个子簇各自的 SSE
+     */
+    void splitCluster(const std::vector<int>& idx, std::vector<int>& left, std::vector<int>& right,
+                      Matrix& centroid, double sse[2]) const {
+        K_Means sub(2, X(idx, Eigen::all).template cast<double>(), Maxiter, tol, LloydEngine,
+                    BatchSize, HistoryStep, PlusPlusInit);
+        for (int i = 0; i < Maxiter; ++i) {
+            if (sub.step(i)) break; // 直接迭代，不记录子问题的历史
+        }
+
+        sse[0] = sse[1] = 0.0;
+        for (size_t p = 0; p < idx.size(); ++p) {
+            int side = sub.labels[p];
+            (side == 0 ? left : right).push_back(idx[p]);
+            sse[side] += (sub.X.row(p) - sub.Center.row(side)).template cast<double>().squaredNorm();
+        }
+        centroid = sub.Center;
+    }
+
+    /**
+     * 二分 K-Means 主流程：每轮按 SSE 从大到小选出若干簇（每个簇每轮至多分裂一次）并行做 2-means 分裂，
+     * 直到得到 K 个簇；每 HistoryStep 次分裂记录一帧历史，最终结果总是最后一帧。可分裂的簇不足时提前结束（K 随之减小）
+     */
+    void startBisecting() {
+        int n = X.rows();
+        std::vector<std::vector<int>> members(1, std::vector<int>(n));
+        std::iota(members[0].begin(), members[0].end(), 0);
+        std::fill(labels.begin(), labels.end(), 0);
+
+        RowVector mean = X.template cast<double>().colwise().mean().template cast<Scalar>();
+        Center = mean;
+        std::vector<double> sse(1, 0.0);
+        for (int i = 0; i < n; ++i) {
+            sse[0] += (X.row(i) - mean).template cast<double>().squaredNorm();
+        }
+
+        int splits = 0;
+        while (static_cast<int>(members.size()) < K) {
+            std::vector<int> order;
+            for (size_t c = 0; c < members.size(); ++c) {
+                if (members[c].size() >= 2 && sse[c] > 0) order.push_back(c);
+            }
+            std::sort(order.begin(), order.end(), [&](int a, int b) { return sse[a] > sse[b]; });
+            order.resize(std::min<int>(order.size(), K - members.size()));
+            if (order.empty()) {
+                break;
+            }
+
+            int m = order.size();
+            std::vector<std::vector<int>> lefts(m), rights(m);
+            std::vector<Matrix> centroids(m);
+            std::vector<double> sses(2 * m);
+
+            // 同一轮内的分裂互不相关，可以并行
+            #pragma omp parallel for schedule(dynamic)
+            for (int t = 0; t < m; ++t) {
+                splitCluster(members[order[t]], lefts[t], rights[t], centroids[t], &sses[2 * t]);
+            }
+
+            for (int t = 0; t < m; ++t) {
+                int c = order[t];
+                if (lefts[t].empty() || rights[t].empty()) {
+                    sse[c] = 0; // 全部为重复点，无法再分
+                    continue;
+                }
+
+                int id = members.size();
+                for (int i : rights[t]) {
+                    labels[i] = id;
+                }
+                members[c] = std::move(lefts[t]);
+                members.push_back(std::move(rights[t]));
+                sse[c] = sses[2 * t];
+                sse.push_back(sses[2 * t + 1]);
+
+                Center.conservativeResize(id + 1, Eigen::NoChange);
+                Center.row(c) = centroids[t].row(0);
+                Center.row(id) = centroids[t].row(1);
+
+                if (++splits % HistoryStep == 0) {
+                    label_history.push_back(labels);
+                    get_center();
+                    center_history.push_back(centers);
+                }
+            }
+        }
+
+        K = members.size();
+        get_center();
+        // 最后一次分裂不在记录步长上（或没有分裂）时补记最终结果，动画总以最终划分结束
+        if (splits == 0 || splits % HistoryStep != 0) {
+            label_history.push_back(labels);
+            center_history.push_back(centers);
+        }
+    }
+
     /**
      * 计算当前聚类的总成本（所有样本到其聚类中心的平方距离之和）
      * @return 当前成本值
@@ -155,9 +945,18 @@ public:
      * 启动整个 K-Means 聚类流程
      */
     void start() {
+        if (Engine == MiniBatchEngine) {
+            startMiniBatch();
+            return;
+        }
+        if (Engine == BisectingEngine) {
+            startBisecting();
+            return;
+        }
+
         int i = 0;
         while (i < Maxiter) {
-            if (update(distance())) {
+            if (step(i)) {
                 break; // 收敛则提前结束
             }
 
@@ -168,6 +967,7 @@ public:
 
             i++;
         }
+        get_center(); // 第一轮即收敛（如热启动时点集未变）时也要输出中心
     }
 
 };
@@ -0,0 +1,285 @@
+#ifndef MST_H
+#define MST_H
+
+#include <vector>
+#include <atomic>
+#include <limits>
+#include <cmath>
+#include <numeric>              // 提供 iota
+#include <algorithm>
+#include <Eigen/Dense>
+#include "KDTree.h"             // Borůvka 的最近异分量邻居查询
+#include "DistanceMatrix.h"     // 稠密 Prim 读取压缩距离矩阵
+
+/**
+ * MSTEdge：最小生成树中的一条边
+ */
+struct MSTEdge {
+    int u;                      // 端点 1
+    int v;                      // 端点 2
+    double weight;              // 边权（欧氏距离或互可达距离）
+
+    bool operator<(const MSTEdge& other) const {
+        if (weight != other.weight) return weight < other.weight;
+        if (u != other.u) return u < other.u;
+        return v < other.v;
+    }
+};
+
+/**
+ * DisjointSet：带路径压缩与按大小合并的并查集
+ */
+struct DisjointSet {
+    std::vector<int> parent;    // 父节点（根的父节点为自身）
+    std::vector<int> size;      // 以该点为根的集合大小
+
+    explicit DisjointSet(int n = 0) : parent(n), size(n, 1) {
+        std::iota(parent.begin(), parent.end(), 0);
+    }
+
+    int find(int x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+
+    /**
+     * 合并 a、b 所在的集合
+     * @return 合并后的根（已在同一集合时返回 -1）
+     */
+    int unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return -1;
+        if (size[a] < size[b]) std::swap(a, b);
+        parent[b] = a;
+        size[a] += size[b];
+        return a;
+    }
+};
+
+/**
+ * 互可达距离 max(core[i], core[j], |xi - xj|)；core 为空时即欧氏距离
+ */
+inline double mutualReachability(double dist, const std::vector<double>& core, int i, int j) {
+    if (core.empty()) return dist;
+    return std::max(dist, std::max(core[i], core[j]));
+}
+
+/**
+ * Prim 算法：在隐式完全图上求最小生成树，每步只维护各点到当前树的最短边
+ * 时间 O(N² D)、额外内存 O(N)，不需要距离矩阵，适合小规模或高维数据
+ * @param X 数据集（每行一个样本）
+ * @param core 每个点的核心距离（为空时边权为欧氏距离）
+ * @return N - 1 条边（按加入顺序）
+ */
+inline std::vector<MSTEdge> primMST(const Eigen::MatrixXd& X, const std::vector<double>& core = std::vector<double>()) {
+    int n = X.rows();
+    std::vector<MSTEdge> edges;
+    if (n <= 1) return edges;
+    edges.reserve(n - 1);
+
+    double inf = std::numeric_limits<double>::infinity();
+    std::vector<double> best(n, inf);   // 到当前树的最短边权
+    std::vector<int> from(n, -1);       // 最短边在树中的端点
+    std::vector<char> inTree(n, 0);
+
+    int cur = 0;
+    inTree[cur] = 1;
+    for (int step = 1; step < n; ++step) {
+        int next = -1;
+        double nextW = inf;
+
+        #pragma omp parallel
+        {
+            int localNext = -1;
+            double localW = inf;
+            #pragma omp for schedule(static)
+            for (int j = 0; j < n; ++j) {
+                if (inTree[j]) continue;
+                double w = mutualReachability((X.row(cur) - X.row(j)).norm(), core, cur, j);
+                if (w < best[j]) {
+                    best[j] = w;
+                    from[j] = cur;
+                }
+                if (best[j] < localW || (best[j] == localW && j < localNext)) {
+                    localW = best[j];
+                    localNext = j;
+                }
+            }
+            #pragma omp critical
+            {
+                if (localNext >= 0 && (localW < nextW || (localW == nextW && localNext < next))) {
+                    nextW = localW;
+                    next = localNext;
+                }
+            }
+        }
+
+        inTree[next] = 1;
+        edges.push_back(MSTEdge{from[next], next, nextW});
+        cur = next;
+    }
+    return edges;
+}
+
+/**
+ * 稠密矩阵上的 Prim 算法：距离已全部算好时直接读取，时间 O(N²)
+ * @param dist 压缩存储的距离矩阵
+ * @return N - 1 条边（按加入顺序）
+ */
+inline std::vector<MSTEdge> primDenseMST(const CondensedDistance& dist) {
+    int n = dist.rows();
+    std::vector<MSTEdge> edges;
+    if (n <= 1) return edges;
+    edges.reserve(n - 1);
+
+    double inf = std::numeric_limits<double>::infinity();
+    std::vector<double> best(n, inf);
+    std::vector<int> from(n, -1);
+    std::vector<char> inTree(n, 0);
+
+    int cur = 0;
+    inTree[cur] = 1;
+    for (int step = 1; step < n; ++step) {
+        int next = -1;
+        for (int j = 0; j < n; ++j) {
+            if (inTree[j]) continue;
+            if (dist(cur, j) < best[j]) {
+                best[j] = dist(cur, j);
+                from[j] = cur;
+            }
+            if (next < 0 || best[j] < best[next]) next = j;
+        }
+        inTree[next] = 1;
+        edges.push_back(MSTEdge{from[next], next, best[next]});
+        cur = next;
+    }
+    return edges;
+}
+
+/**
+ * Borůvka 算法：每轮为每个连通分量找一条最短的外连边并全部加入，O(log N) 轮后得到生成树
+ * 最近异分量邻居在 kd 树上查询：整棵子树都属于同一分量、或包围盒距离（与子树最小核心距离）
+ * 已大于当前最优边的节点整体跳过（严格大于，等长的候选边都会被检查）；每个分量当前最优边权在线程间共享，用于提前剪枝
+ * @param tree 数据集上的 kd 树
+ * @param core 每个点的核心距离（为空时边权为欧氏距离）
+ * @return N - 1 条边（按加入顺序）
+ */
+inline std::vector<MSTEdge> boruvkaMST(const KDTree<double>& tree, const std::vector<double>& core = std::vector<double>()) {
+    const KDTree<double>::Matrix& X = tree.data();
+    int n = X.rows();
+    std::vector<MSTEdge> edges;
+    if (n <= 1) return edges;
+    edges.reserve(n - 1);
+
+    double inf = std::numeric_limits<double>::infinity();
+    int nnodes = tree.nodes.size();
+
+    // 每个节点内的最小核心距离（子节点下标总大于父节点，逆序即自底向上）
+    std::vector<double> minCore(nnodes, 0.0);
+    if (!core.empty()) {
+        for (int id = nnodes - 1; id >= 0; --id) {
+            const KDTree<double>::Node& node = tree.nodes[id];
+            if (node.isLeaf()) {
+                double m = inf;
+                for (int t = node.begin; t < node.end; ++t) m = std::min(m, core[tree.perm[t]]);
+                minCore[id] = m;
+            } else {
+                minCore[id] = std::min(minCore[node.left], minCore[node.right]);
+            }
+        }
+    }
+    auto coreOf = [&](int i) { return core.empty() ? 0.0 : core[i]; };
+
+    DisjointSet dsu(n);
+    std::vector<int> comp(n);               // 每个点所在分量（并查集的根）
+    std::vector<int> nodeComp(nnodes);      // 节点内所有点同属的分量（不唯一时为 -1）
+    std::vector<std::atomic<double>> compBound(n); // 每个分量当前找到的最短外连边权
+    std::vector<double> pointW(n);
+    std::vector<int> pointTo(n);
+
+    int components = n;
+    while (components > 1) {
+        for (int i = 0; i < n; ++i) comp[i] = dsu.find(i);
+        for (int id = nnodes - 1; id >= 0; --id) {
+            const KDTree<double>::Node& node = tree.nodes[id];
+            if (node.isLeaf()) {
+                int c = comp[tree.perm[node.begin]];
+                for (int t = node.begin + 1; t < node.end && c >= 0; ++t) {
+                    if (comp[tree.perm[t]] != c) c = -1;
+                }
+                nodeComp[id] = c;
+            } else {
+                nodeComp[id] = nodeComp[node.left] == nodeComp[node.right] ? nodeComp[node.left] : -1;
+            }
+        }
+        for (int i = 0; i < n; ++i) compBound[i].store(inf, std::memory_order_relaxed);
+
+        // 每个点在 kd 树上查询最近的异分量邻居
+        #pragma omp parallel for schedule(dynamic, 256)
+        for (int i = 0; i < n; ++i) {
+            int c = comp[i];
+            double ci = coreOf(i);
+            pointW[i] = inf;
+            pointTo[i] = -1;
+            if (ci > compBound[c].load(std::memory_order_relaxed)) continue; // 本点的任何边都不可能更短或等长
+
+            KDTree<double>::Point q = X.row(i).transpose();
+            std::vector<int> stack(1, 0);
+            while (!stack.empty()) {
+                int id = stack.back();
+                stack.pop_back();
+                if (nodeComp[id] == c) continue;
+                double bound = std::min(pointW[i], compBound[c].load(std::memory_order_relaxed));
+                double lb = std::max(std::sqrt(tree.boxDistanceSq(id, q)), std::max(ci, minCore[id]));
+                if (lb > bound) continue; // 等于界时仍要检查：等长边需按端点下标比较，不能因线程先后被跳过
+
+                const KDTree<double>::Node& node = tree.nodes[id];
+                if (node.isLeaf()) {
+                    for (int t = node.begin; t < node.end; ++t) {
+                        int j = tree.perm[t];
+                        if (comp[j] == c) continue;
+                        double w = mutualReachability((X.row(i) - X.row(j)).norm(), core, i, j);
+                        if (w < pointW[i] || (w == pointW[i] && j < pointTo[i])) {
+                            pointW[i] = w;
+                            pointTo[i] = j;
+                        }
+                    }
+                    // 更新分量共享的剪枝界
+                    double cur = compBound[c].load(std::memory_order_relaxed);
+                    while (pointW[i] < cur && !compBound[c].compare_exchange_weak(cur, pointW[i], std::memory_order_relaxed)) {
+                    }
+                } else {
+                    // 较近的子节点后入栈、先处理
+                    int nearer = node.left, farther = node.right;
+                    if (tree.boxDistanceSq(farther, q) < tree.boxDistanceSq(nearer, q)) std::swap(nearer, farther);
+                    stack.push_back(farther);
+                    stack.push_back(nearer);
+                }
+            }
+        }
+
+        // 每个分量取最短的外连边（相同边权按端点下标，保证结果确定）
+        std::vector<MSTEdge> best(n, MSTEdge{-1, -1, inf});
+        for (int i = 0; i < n; ++i) {
+            if (pointTo[i] < 0) continue;
+            MSTEdge e{std::min(i, pointTo[i]), std::max(i, pointTo[i]), pointW[i]};
+            if (best[comp[i]].u < 0 || e < best[comp[i]]) best[comp[i]] = e;
+        }
+        int added = 0;
+        for (int c = 0; c < n; ++c) {
+            if (best[c].u >= 0 && dsu.unite(best[c].u, best[c].v) >= 0) {
+                edges.push_back(best[c]);
+                added++;
+            }
+        }
+        if (added == 0) break;
+        components -= added;
+    }
+    return edges;
+}
+
+#endif // MST_H
@@ -0,0 +1,186 @@
+#ifndef OPTICS_H
+#define OPTICS_H
+
+#include <vector>
+#include <queue>
+#include <limits>
+#include <algorithm>
+#include <Eigen/Dense>
+#include "DBSCAN.h"             // Pointtype
+#include "GridIndex.h"          // 均匀网格空间哈希（邻域查询）
+
+/**
+ * OPTICS：按可达距离对样本排序（Ordering Points To Identify the Clustering Structure）
+ * 对给定的 (数据集, Minpts, 生成半径 MaxEps) 只需运行一次，之后任意 eps ≤ MaxEps 的 DBSCAN 结果
+ * 都可以由排序与核心距离在 O(N) 内提取（边界点另需各查询一次邻域）
+ */
+class OPTICS {
+private:
+    double MaxEps;                  // 生成半径（邻域查询的最大半径）
+    int Minpts;                     // 成为核心点所需的最小邻域点数（不含自身，与 DBSCAN 一致）
+    Eigen::MatrixXd X;              // 输入数据集（每行一个样本）
+    GridIndex Grid;                 // 以 MaxEps 为边长的网格索引
+
+public:
+    std::vector<double> core_dist;  // 核心距离：到第 Minpts 个最近邻的距离（超过 MaxEps 为无穷大）
+    std::vector<double> nn_dist;    // 到最近邻的距离（判断边界点；超过 MaxEps 为无穷大）
+    std::vector<double> reachability; // 可达距离（按样本下标；排序中每段的第一个点为无穷大）
+    std::vector<int> ordering;      // OPTICS 排序（样本下标）
+
+    std::vector<int> labels;                // 最近一次提取的标签（-1 表示噪声）
+    std::vector<Pointtype> point_features;  // 最近一次提取的点类型
+
+    /**
+     * 构造函数
+     * @param maxeps 生成半径（之后可提取任意不超过该值的 eps）
+     * @param minpts 最小邻域点数
+     * @param x 数据集（每行一个样本）
+     */
+    OPTICS(double maxeps, int minpts, Eigen::MatrixXd x)
+        : MaxEps(maxeps), Minpts(minpts), X(x) {
+        int n = X.rows();
+        double inf = std::numeric_limits<double>::infinity();
+        core_dist = std::vector<double>(n, inf);
+        nn_dist = std::vector<double>(n, inf);
+        reachability = std::vector<double>(n, inf);
+        labels = std::vector<int>(n, -1);
+        point_features = std::vector<Pointtype>(n, Noisepoint);
+    }
+
+    double maxEps() const { return MaxEps; }
+    int minpts() const { return Minpts; }
+    const Eigen::MatrixXd& data() const { return X; }
+
+    /**
+     * 计算每个点的核心距离与最近邻距离
+     */
+    void coreDistance() {
+        int n = X.rows();
+        Grid = GridIndex(X, MaxEps);
+
+        #pragma omp parallel for schedule(dynamic, 256)
+        for (int i = 0; i < n; ++i) {
+            std::vector<double> d;
+            for (int j : Grid.radiusSearch(i, MaxEps)) {
+                d.push_back((X.row(i) - X.row(j)).norm());
+            }
+            if (d.empty()) continue;
+            nn_dist[i] = *std::min_element(d.begin(), d.end());
+            if (static_cast<int>(d.size()) >= Minpts && Minpts > 0) {
+                std::nth_element(d.begin(), d.begin() + Minpts - 1, d.end());
+                core_dist[i] = d[Minpts - 1];
+            } else if (Minpts <= 0) {
+                core_dist[i] = 0.0;
+            }
+        }
+    }
+
+    /**
+     * 生成 OPTICS 排序：每次从种子集中取可达距离最小的点，并用它的核心距离更新邻居的可达距离
+     */
+    void order() {
+        int n = X.rows();
+        std::vector<bool> processed(n, false);
+        ordering.clear();
+        ordering.reserve(n);
+
+        // 种子集：小顶堆 (可达距离, 下标)，过期条目在弹出时跳过
+        using Seed = std::pair<double, int>;
+        std::priority_queue<Seed, std::vector<Seed>, std::greater<Seed>> seeds;
+
+        for (int start = 0; start < n; ++start) {
+            if (processed[start]) continue;
+            seeds.push(Seed(reachability[start], start));
+
+            while (!seeds.empty()) {
+                Seed top = seeds.top();
+                seeds.pop();
+                int p = top.second;
+                if (processed[p] || top.first > reachability[p]) continue;
+
+                processed[p] = true;
+                ordering.push_back(p);
+                if (core_dist[p] > MaxEps) continue; // 非核心点不扩展
+
+                for (int j : Grid.radiusSearch(p, MaxEps)) {
+                    if (processed[j]) continue;
+                    double r = std::max(core_dist[p], (X.row(p) - X.row(j)).norm());
+                    if (r < reachability[j]) {
+                        reachability[j] = r;
+                        seeds.push(Seed(r, j));
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * 从排序中提取半径 eps（≤ MaxEps）下的 DBSCAN 结果：核心点的簇由排序 O(N) 得到，
+     * 簇按最小核心点下标编号（与 DBSCAN 的编号顺序相同）；排序只能保证边界点被“先到达它的簇”认领，
+     * 因此再对边界点查询一次邻域，归入相邻核心点中编号最小的簇，使结果与 DBSCAN 完全一致
+     * @param eps 邻域半径
+     */
+    void extract(double eps) {
+        eps = std::min(eps, MaxEps);
+        int n = X.rows();
+        std::vector<int> raw(n, -1);
+        int cluster = -1;
+        for (int p : ordering) {
+            if (reachability[p] > eps) {
+                // 不能从前面的点到达：若自身是核心点则开始新簇，否则为噪声
+                if (core_dist[p] <= eps) {
+                    raw[p] = ++cluster;
+                }
+            } else {
+                raw[p] = cluster;
+            }
+        }
+
+        // 规范化编号：按每个簇最小的核心点下标排序
+        std::vector<int> remap(cluster + 1, -1);
+        int next = 0;
+        for (int i = 0; i < n; ++i) {
+            if (raw[i] >= 0 && core_dist[i] <= eps && remap[raw[i]] < 0) {
+                remap[raw[i]] = next++;
+            }
+        }
+        for (int i = 0; i < n; ++i) {
+            if (core_dist[i] <= eps) {
+                labels[i] = remap[raw[i]];
+                point_features[i] = Corepoint;
+            } else {
+                labels[i] = -1;
+                point_features[i] = nn_dist[i] <= eps ? Marginpoint : Noisepoint;
+            }
+        }
+
+        // 边界点：只有邻域非空的非核心点才可能属于某个簇
+        double eps_sq = eps * eps;
+        #pragma omp parallel for schedule(dynamic, 256)
+        for (int i = 0; i < n; ++i) {
+            if (point_features[i] != Marginpoint) continue;
+            int best = -1;
+            Grid.forEachNeighborCell(X.row(i), [&](const std::vector<int>& cell) {
+                for (int j : cell) {
+                    if (core_dist[j] <= eps && (best < 0 || labels[j] < best) &&
+                        (X.row(i) - X.row(j)).squaredNorm() <= eps_sq) {
+                        best = labels[j];
+                    }
+                }
+            });
+            labels[i] = best;
+        }
+    }
+
+    /**
+     * 启动 OPTICS：计算核心距离并生成排序，然后按 MaxEps 提取一次结果
+     */
+    void start() {
+        coreDistance();
+        order();
+        extract(MaxEps);
+    }
+
+};
+
+#endif // OPTICS_H
@@ -9,6 +9,7 @@
 #include <algorithm>            // 提供 shuffle 等算法
 #include <random>               // 用于随机初始化
 #include "K_Means.h"            // 引入 K-Means 聚类类
+#include "DistanceMatrix.h"     // 压缩存储的距离矩阵
 
 // 归一化方式枚举类型
 enum Norm {
@@ -19,6 +20,8 @@ enum Norm {
 
 /**
  * Spectral：实现谱聚类算法（Spectral Clustering）
+ * 压缩距离只去掉了构建 W 时的临时矩阵；W、D、L 及特征分解仍是稠密 N × N 的 double 矩阵，
+ * 内存与时间分别为 O(N²) 与 O(N³)，不适用于数万点规模
  */
 class Spectral {
 private:
@@ -26,6 +29,7 @@ private:
     double Sigma;       // RBF 核宽度参数
     Eigen::MatrixXd X;  // 输入数据集（每行一个样本）
     Norm Normstyle;     // 拉普拉斯矩阵归一化方式
+    bool UseFloat;      // 距离矩阵是否以 float 存储
 
 public:
     std::vector<int> labels;                // 最终聚类标签
@@ -37,32 +41,37 @@ public:
      * @param x 输入数据矩阵（每行一个样本）
      * @param normstyle 使用哪种归一化方式（默认为 NoNorm）
      * @param sigma RBF 核宽度参数（默认为1.0）
+     * @param useFloat 距离矩阵是否以 float 存储（默认为 double）
      */
-    Spectral(int k, Eigen::MatrixXd x, Norm normstyle = NoNorm, double sigma = 1.0)
-        : K(k), X(x), Normstyle(normstyle), Sigma(sigma) {}
+    Spectral(int k, Eigen::MatrixXd x, Norm normstyle = NoNorm, double sigma = 1.0, bool useFloat = false)
+        : K(k), X(x), Normstyle(normstyle), Sigma(sigma), UseFloat(useFloat) {}
 
     /**
      * 计算所有点之间的欧氏距离矩阵
-     * @return 距离矩阵（N × N）
+     * @return 压缩存储的距离矩阵
      */
-    Eigen::MatrixXd distance() {
-        Eigen::VectorXd row_norms = X.rowwise().squaredNorm(); // 每个样本的平方L2范数
-        Eigen::MatrixXd dot_products = X * X.transpose();      // 点积矩阵
-        Eigen::MatrixXd dists = (-2 * dot_products).rowwise() + row_norms.transpose();
-        dists = dists.colwise() + row_norms;
-        return dists.array().sqrt(); // 返回欧氏距离矩阵
+    CondensedDistance distance() {
+        return CondensedDistance(X, false, UseFloat);
     }
 
     /**
-     * 构建相似度矩阵 W（使用 RBF 核）
+     * 构建相似度矩阵 W（使用 RBF 核），直接由压缩距离逐对填充
      * @param sigma RBF 核宽度参数
      * @return 相似度矩阵 W
      */
     Eigen::MatrixXd getW(double sigma = 1.0) {
-        Eigen::MatrixXd dists = distance();
-
-        Eigen::MatrixXd W = (-dists / (2 * sigma * sigma)).array().exp(); // RBF核计算
-        W.diagonal().setZero(); // 自环边置零
+        CondensedDistance dists = distance();
+        int n = X.rows();
+
+        Eigen::MatrixXd W = Eigen::MatrixXd::Zero(n, n); // 自环边为零
+        #pragma omp parallel for schedule(dynamic, 64)
+        for (int i = 0; i < n; ++i) {
+            for (int j = i + 1; j < n; ++j) {
+                double w = std::exp(-dists(i, j) / (2 * sigma * sigma)); // RBF核计算
+                W(i, j) = w;
+                W(j, i) = w;
+            }
+        }
         return W;
     }
 
@@ -174,8 +183,8 @@ public:
         // 提取前 K 个最小非零特征值对应的特征向量
         Eigen::MatrixXd U = getEigen(L);
 
-        // 在特征空间上运行 K-Means 聚类
-        K_Means k_means = K_Means(K, U, 30, 1e-4);
+        // 在特征空间上运行 K-Means 聚类（k-means++ 初始化，减少达到 Maxiter 仍未收敛的情况）
+        K_Means<> k_means = K_Means<>(K, U, 30, 1e-4, LloydEngine, 1024, 10, PlusPlusInit);
         k_means.start();
 
         // 保存结果
@@ -36,7 +36,7 @@ int main(){
     if(type == k_means){
         int K = 3;
         int Maxiter = 20;
-        K_Means c = K_Means(K, X, Maxiter);
+        K_Means<> c = K_Means<>(K, X, Maxiter);
         c.start();
     }
     if(type == dbscan){
@@ -0,0 +1,103 @@
+#include "LineChartWidget.h"
+#include <QPainter>
+#include <QPolygonF>
+#include <algorithm>
+
+/**
+ * 构造函数：初始化折线图控件
+ * @param parent 父级 QWidget，默认为 nullptr
+ */
+LineChartWidget::LineChartWidget(QWidget *parent)
+    : QWidget(parent)
+{
+    setMinimumSize(600, 400); // 设置最小尺寸
+}
+
+/**
+ * 设置折线图数据
+ * @param ks 每个数据点的 K
+ * @param costs 每个 K 对应的代价
+ * @param elbow 肘部在序列中的下标（-1 表示不标出）
+ */
+void LineChartWidget::setData(const std::vector<int> &ks, const std::vector<double> &costs, int elbow)
+{
+    ks_ = ks;
+    costs_ = costs;
+    elbow_ = elbow;
+
+    maxCost_ = 1.0;
+    if (!costs_.empty()) {
+        maxCost_ = *std::max_element(costs_.begin(), costs_.end()); // 找到最大代价
+        if (maxCost_ <= 0) maxCost_ = 1.0;
+    }
+
+    update(); // 触发重绘事件
+}
+
+/**
+ * 绘制事件处理函数：绘制坐标轴、刻度、代价折线以及肘部标记
+ * @param event QPaintEvent 对象（未使用）
+ */
+void LineChartWidget::paintEvent(QPaintEvent *)
+{
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing); // 抗锯齿渲染
+
+    int margin = 60;                          // 边距
+    int chartWidth = width() - 2 * margin;    // 图表区域宽度
+    int chartHeight = height() - 2 * margin;  // 图表区域高度
+
+    // 清除背景为白色
+    painter.fillRect(rect(), Qt::white);
+
+    // 绘制坐标轴 X 和 Y
+    painter.setPen(Qt::black);
+    painter.drawLine(margin, height() - margin, width() - margin, height() - margin); // X 轴
+    painter.drawLine(margin, margin, margin, height() - margin);                      // Y 轴
+    painter.drawText(width() - margin + 10, height() - margin + 4, "K");
+    painter.drawText(margin - 20, margin - 15, "Inertia");
+
+    // 绘制 Y 轴刻度和标签（分为 5 段）
+    for (int i = 0; i <= 5; ++i) {
+        int yPos = height() - margin - (chartHeight * i / 5);
+        painter.drawLine(margin - 5, yPos, margin, yPos);
+        QString label = QString::number(maxCost_ * i / 5, 'g', 3);
+        painter.drawText(margin - 55, yPos + 4, label);
+    }
+
+    if (ks_.empty()) {
+        return;
+    }
+
+    // 数据点的像素坐标：K 等距排布在横轴上
+    int n = ks_.size();
+    QPolygonF line;
+    for (int i = 0; i < n; ++i) {
+        double x = margin + (n == 1 ? chartWidth / 2.0 : chartWidth * double(i) / (n - 1));
+        double y = height() - margin - (costs_[i] / maxCost_) * chartHeight;
+        line << QPointF(x, y);
+    }
+
+    // 绘制折线、数据点与 X 轴刻度
+    painter.setPen(QPen(Qt::darkBlue, 2));
+    painter.drawPolyline(line);
+    painter.setBrush(Qt::darkBlue);
+    int labelStep = std::max(1, n / 20); // 点太多时隔几个标一次 K
+    for (int i = 0; i < n; ++i) {
+        painter.setPen(Qt::darkBlue);
+        painter.drawEllipse(line[i], 3, 3);
+        if (i % labelStep == 0 || i == elbow_) {
+            painter.setPen(Qt::black);
+            painter.drawText(QPointF(line[i].x() - 6, height() - margin + 18), QString::number(ks_[i]));
+        }
+    }
+
+    // 肘部：红色空心圆并标注所选 K
+    if (elbow_ >= 0 && elbow_ < n) {
+        painter.setPen(QPen(Qt::red, 2));
+        painter.setBrush(Qt::NoBrush);
+        painter.drawEllipse(line[elbow_], 8, 8);
+        painter.drawText(QPointF(line[elbow_].x() + 12, line[elbow_].y() - 12),
+                         QString("Elbow K = %1").arg(ks_[elbow_]));
+    }
+}
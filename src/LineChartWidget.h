@@ -0,0 +1,44 @@
+#ifndef LINECHARTWIDGET_H
+#define LINECHARTWIDGET_H
+
+#include <QWidget> // 包含 QWidget 类定义，用于创建自定义控件
+#include <vector>  // 使用 std::vector 容器
+
+/**
+ * @class LineChartWidget
+ * 自定义的 Qt 控件，用于绘制折线图（K 扫描的代价曲线）。
+ * 横轴为 K，纵轴为代价（inertia），并突出显示肘部法选出的 K。
+ */
+class LineChartWidget : public QWidget {
+    Q_OBJECT // 必须在继承自 QObject 的类中声明（如 QWidget），以启用信号和槽机制
+
+public:
+    /**
+     * 构造函数
+     * @param parent 父级 widget，默认为 nullptr
+     */
+    explicit LineChartWidget(QWidget *parent = nullptr);
+
+    /**
+     * 设置或更新折线图的数据。
+     * @param ks 每个数据点的 K
+     * @param costs 每个 K 对应的代价
+     * @param elbow 肘部在序列中的下标（-1 表示不标出）
+     */
+    void setData(const std::vector<int> &ks, const std::vector<double> &costs, int elbow);
+
+protected:
+    /**
+     * 重写的 paintEvent 函数，用于绘制折线图。
+     * @param event 绘制事件对象
+     */
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    std::vector<int> ks_;       // 横轴：各个 K
+    std::vector<double> costs_; // 纵轴：每个 K 的代价
+    int elbow_ = -1;            // 肘部下标
+    double maxCost_ = 1.0;      // 最大代价，用于纵轴缩放
+};
+
+#endif // LINECHARTWIDGET_H
@@ -0,0 +1,31 @@
+#include "ShowInertia.h"  // 对应的头文件声明
+
+/**
+ * @brief 构造函数：创建一个显示 K 扫描代价曲线的子窗口
+ * @param parent 父级 QWidget，默认为 nullptr
+ */
+SubWindowInertia::SubWindowInertia(QWidget *parent)
+    : QDialog(parent)
+{
+    // 设置窗口标题
+    setWindowTitle("Inertia Curve");
+
+    // 创建折线图控件（随窗口缩放）
+    chartWidget_ = new LineChartWidget(this);
+
+    // 创建主布局并添加折线图
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addWidget(chartWidget_);
+    setLayout(layout);
+}
+
+/**
+ * @brief 设置子窗口中要显示的代价曲线
+ * @param ks 扫描的各个 K
+ * @param costs 每个 K 的代价
+ * @param elbow 肘部在序列中的下标
+ */
+void SubWindowInertia::setData(const std::vector<int> &ks, const std::vector<double> &costs, int elbow)
+{
+    chartWidget_->setData(ks, costs, elbow);
+}
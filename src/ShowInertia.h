@@ -0,0 +1,40 @@
+#ifndef SHOWINERTIA_H
+#define SHOWINERTIA_H
+
+// Qt 标准库头文件
+#include <QDialog>        // 用于创建子窗口对话框
+#include <QVBoxLayout>    // 垂直布局管理器
+
+// 自定义控件头文件
+#include "LineChartWidget.h" // 折线图绘制控件
+
+/**
+ * @class SubWindowInertia
+ * @brief 显示 K 扫描代价曲线的子窗口类。
+ *
+ * 该类继承自 QDialog，用于在独立窗口中展示 K-Means 在 [k, kMax] 上每个 K 的代价（inertia），
+ * 并标出肘部法选出的 K，便于比较不同 K 的聚类效果。
+ */
+class SubWindowInertia : public QDialog {
+    Q_OBJECT // 启用 Qt 的信号与槽机制
+
+public:
+    /**
+     * 构造函数：初始化子窗口界面
+     * @param parent 父级 QWidget，默认为 nullptr
+     */
+    explicit SubWindowInertia(QWidget *parent = nullptr);
+
+    /**
+     * 设置要显示的代价曲线
+     * @param ks 扫描的各个 K
+     * @param costs 每个 K 的代价
+     * @param elbow 肘部在序列中的下标
+     */
+    void setData(const std::vector<int> &ks, const std::vector<double> &costs, int elbow);
+
+private:
+    LineChartWidget *chartWidget_; ///< 实际用于绘制折线图的自定义控件
+};
+
+#endif // SHOWINERTIA_H
@@ -40,26 +40,28 @@ SubWindowTree::SubWindowTree(QWidget *parent)
  * 该方法将传入的聚类树根节点、点坐标、标签及目标聚类数传递给底层的树状图控件，
  * 并根据树的最大高度和点的数量动态调整图表大小以适应滚动查看。
  *
- * @param roots 层次聚类树的根节点列表（每个根代表一棵树）
+ * @param tree 层次聚类树的节点池
+ * @param roots 根节点 ID 列表（每个根代表一棵树）
  * @param points 数据点坐标列表（用于标注或绘图）
  * @param labels 每个点对应的类别标签（用于颜色映射）
  * @param nclusters 目标聚类数量（用于可视化分层切割）
  */
-void SubWindowTree::setData(const std::vector<ClusterNode*> &roots,
+void SubWindowTree::setData(const std::shared_ptr<const Dendrogram> &tree,
+                             const std::vector<int> &roots,
                              const QList<QPointF> &points,
                              const std::vector<int> &labels,
                              int nclusters)
 {
     // 计算所有树中的最大高度，用于确定图表的垂直空间
     int max_height = 0;
-    for (auto root : roots) {
-        if (root->height > max_height) {
-            max_height = root->height;
+    for (int root : roots) {
+        if ((*tree)[root].height > max_height) {
+            max_height = (*tree)[root].height;
         }
     }
 
     // 将数据传递给树状图控件进行显示
-    chartWidget_->setData(roots, points, labels, max_height, nclusters);
+    chartWidget_->setData(tree, roots, points, labels, max_height, nclusters);
 
     // 动态调整树状图控件的大小：
     // 宽度 = 每个点的宽度（PERWIDTH） × 点的数量；
@@ -12,9 +12,6 @@
 // 自定义控件头文件
 #include "TreeChartWidget.h" // 树状图绘制控件（需自行实现）
 
-// 前向声明 ClusterNode 结构体/类（避免包含整个头文件）
-class ClusterNode;
-
 /**
  * @class SubWindowTree
  * @brief 显示层次聚类树结构的子窗口类。
@@ -36,12 +33,14 @@ public:
     /**
      * 设置要显示的层次聚类树数据及其相关点坐标和标签
      *
-     * @param roots 层次聚类树的根节点列表（每个根代表一棵树）
+     * @param tree 层次聚类树的节点池
+     * @param roots 根节点 ID 列表（每个根代表一棵树）
      * @param points 数据点坐标列表（用于标注或绘图）
      * @param labels 每个点对应的类别标签（用于颜色映射）
      * @param nclusters 目标聚类数量（用于在树上标记切割层级）
      */
-    void setData(const std::vector<ClusterNode*> &roots,
+    void setData(const std::shared_ptr<const Dendrogram> &tree,
+                 const std::vector<int> &roots,
                  const QList<QPointF> &points,
                  const std::vector<int> &labels,
                  int nclusters);
@@ -36,18 +36,21 @@ void TreeChartWidget::initColorBiases(int n_clusters) {
 /**
  * @brief 设置树状图所需的数据
  *
- * @param roots 层次聚类树的根节点列表
+ * @param tree 层次聚类树的节点池
+ * @param roots 根节点 ID 列表
  * @param points 数据点坐标列表
  * @param labels 每个点对应的标签（用于颜色映射）
  * @param maxheight 树的最大高度（用于布局计算）
  * @param nclusters 目标聚类数量（用于颜色区分）
  */
-void TreeChartWidget::setData(const std::vector<ClusterNode*>& roots,
+void TreeChartWidget::setData(const std::shared_ptr<const Dendrogram>& tree,
+                              const std::vector<int>& roots,
                               const QList<QPointF>& points,
                               const std::vector<int>& labels,
                               int maxheight,
                               int nclusters)
 {
+    tree_ = tree;
     roots_ = roots;
     points_ = points;
     labels_ = labels;
@@ -66,7 +69,7 @@ void TreeChartWidget::paintEvent(QPaintEvent*)
     QPainter painter(this);
     painter.setRenderHint(QPainter::Antialiasing); // 启用抗锯齿
 
-    if (roots_.empty()) {
+    if (!tree_ || roots_.empty()) {
         return; // 如果没有数据，不进行绘制
     }
 
@@ -102,16 +105,17 @@ void TreeChartWidget::paintEvent(QPaintEvent*)
 
     QFontMetrics fm(painter.font());
 
-    // X轴数据点标注
+    // X轴数据点标注（第 i 个位置对应叶序排列中的第 i 个样本）
     for (int i = 0; i < points_.size(); i++) {
         int x = MARGIN + (i + 1) * PERWIDTH - 10;
+        int p = i < static_cast<int>(tree_->order.size()) ? tree_->order[i] : i;
 
-        QString labelText = QString("P%1").arg(i); // 点编号
+        QString labelText = QString("P%1").arg(p); // 点编号
         painter.drawText(x, MARGIN + chartHeight + 15, labelText);
 
         // 显示每个点的坐标 (x, y)
-        if (i < points_.size()) {
-            QPointF point = points_[i];
+        if (p < points_.size()) {
+            QPointF point = points_[p];
             QString xpointLabel = QString("%1").arg(point.x(), 0, 'f', 2); // 保留两位小数
             int xtextWidth = fm.horizontalAdvance(xpointLabel);
             painter.drawText(x, MARGIN + chartHeight + 32, xpointLabel);
@@ -122,40 +126,42 @@ void TreeChartWidget::paintEvent(QPaintEvent*)
     }
 
     // 遍历所有根节点并绘制树结构
-    for (auto root : roots_) {
-        drawNode(painter, root, chartHeight);
+    for (int root : roots_) {
+        drawNode(painter, (*tree_)[root], chartHeight);
     }
 }
 
 /**
  * @brief 递归绘制树节点及其连接线
  * @param painter QPainter 对象
- * @param node 当前节点指针
+ * @param node 当前节点
  * @param chartHeight 图表总高度
  * @return 返回当前节点的 X 坐标和对应标签
  */
-std::pair<int, int> TreeChartWidget::drawNode(QPainter& painter, ClusterNode* node, int chartHeight)
+std::pair<int, int> TreeChartWidget::drawNode(QPainter& painter, const ClusterNode& node, int chartHeight)
 {
     int label;
     int startx;
 
     // 如果是叶子节点
-    if (node->left == nullptr && node->right == nullptr) {
-        if (node->id < static_cast<int>(labels_.size())) {
-            label = labels_[node->id]; // 获取标签
+    if (node.isLeaf()) {
+        if (node.id < static_cast<int>(labels_.size())) {
+            label = labels_[node.id]; // 获取标签
         } else {
             label = -2; // 无效标签
         }
 
-        // 计算该点在 X 轴上的位置
-        startx = (node->id + 1) * PERWIDTH + MARGIN;
+        // 按叶序排列计算该点在 X 轴上的位置，使每棵子树的叶子相邻、连线不交叉
+        startx = (node.begin + 1) * PERWIDTH + MARGIN;
 
         return std::make_pair(startx, label);
     }
 
     // 递归绘制左右子节点
-    std::pair<int, int> left_node = drawNode(painter, node->left, chartHeight);
-    std::pair<int, int> right_node = drawNode(painter, node->right, chartHeight);
+    const ClusterNode& left = (*tree_)[node.left];
+    const ClusterNode& right = (*tree_)[node.right];
+    std::pair<int, int> left_node = drawNode(painter, left, chartHeight);
+    std::pair<int, int> right_node = drawNode(painter, right, chartHeight);
 
     startx = (left_node.first + right_node.first) / 2; // 当前节点居中于两个子节点之间
 
@@ -175,22 +181,23 @@ std::pair<int, int> TreeChartWidget::drawNode(QPainter& painter, ClusterNode* no
     painter.setPen(pen);
 
     // 获取左右子节点 Y 方向偏移
-    int left_bias = MARGIN + chartHeight - PERHEIGHT * node->left->height;
-    int right_bias = MARGIN + chartHeight - PERHEIGHT * node->right->height;
+    int left_bias = MARGIN + chartHeight - PERHEIGHT * left.height;
+    int right_bias = MARGIN + chartHeight - PERHEIGHT * right.height;
 
-    // 如果子节点不是叶子，则加上颜色偏移
-    if (node->left->id >= static_cast<int>(labels_.size())) {
+    // 如果子节点不是叶子，则加上颜色偏移（混合或噪声子树没有偏移）
+    int nbiases = static_cast<int>(colorBiases_.size());
+    if (!left.isLeaf() && left_node.second >= 0 && left_node.second < nbiases) {
         left_bias += colorBiases_[left_node.second];
     }
-    if (node->right->id >= static_cast<int>(labels_.size())) {
+    if (!right.isLeaf() && right_node.second >= 0 && right_node.second < nbiases) {
         right_bias += colorBiases_[right_node.second];
     }
 
     // 绘制连接线
-    painter.drawLine(left_node.first, left_bias, left_node.first, MARGIN + chartHeight - PERHEIGHT * node->height);
-    painter.drawLine(right_node.first, right_bias, right_node.first, MARGIN + chartHeight - PERHEIGHT * node->height);
-    painter.drawLine(left_node.first, MARGIN + chartHeight - PERHEIGHT * node->height,
-                     right_node.first, MARGIN + chartHeight - PERHEIGHT * node->height);
+    painter.drawLine(left_node.first, left_bias, left_node.first, MARGIN + chartHeight - PERHEIGHT * node.height);
+    painter.drawLine(right_node.first, right_bias, right_node.first, MARGIN + chartHeight - PERHEIGHT * node.height);
+    painter.drawLine(left_node.first, MARGIN + chartHeight - PERHEIGHT * node.height,
+                     right_node.first, MARGIN + chartHeight - PERHEIGHT * node.height);
 
     // 返回当前节点的 X 坐标和标签
     return std::make_pair(startx, label);
@@ -7,7 +7,8 @@
 #include <vector>           // 使用 vector 存储聚类节点和标签数据
 #include <QList>            // 使用 QList 存储 QPointF 类型的数据点
 #include <QPoint>           // 用于表示二维坐标点（虽然主要是 QPointF 在用）
-#include "clustering/Cluster.h"  // 包含 ClusterNode 定义（层次聚类树的节点结构）
+#include <memory>           // 共享持有聚类树节点池
+#include "clustering/Cluster.h"  // 包含 Dendrogram 定义（层次聚类树的节点池）
 
 // 图表边距常量定义
 #define MARGIN    50     // 图表四周留白边距（像素）
@@ -34,13 +35,15 @@ public:
     /**
      * 设置要绘制的聚类树数据
      *
-     * @param roots 层次聚类树的根节点列表（每个根代表一棵树）
+     * @param tree 层次聚类树的节点池
+     * @param roots 根节点 ID 列表（每个根代表一棵树）
      * @param points 数据点坐标列表（用于标注或绘图）
      * @param labels 每个点对应的类别标签（用于颜色映射）
      * @param maxheight 树的最大高度（用于图表布局计算）
      * @param nclusters 目标聚类数量（用于颜色区分）
      */
-    void setData(const std::vector<ClusterNode*> &roots,
+    void setData(const std::shared_ptr<const Dendrogram> &tree,
+                 const std::vector<int> &roots,
                  const QList<QPointF> &points,
                  const std::vector<int> &labels,
                  int maxheight,
@@ -60,7 +63,7 @@ public:
      * @param chartHeight 图表总高度
      * @return 返回当前节点在 X 轴上的位置及对应标签
      */
-    std::pair<int, int> drawNode(QPainter& painter, ClusterNode* node, int chartHeight);
+    std::pair<int, int> drawNode(QPainter& painter, const ClusterNode& node, int chartHeight);
 
 protected:
     /**
@@ -71,7 +74,8 @@ protected:
 
 private:
     int max_height;                    ///< 树的最大高度，用于布局计算
-    std::vector<ClusterNode*> roots_; ///< 聚类树的根节点列表
+    std::shared_ptr<const Dendrogram> tree_; ///< 聚类树节点池（与聚类结果共享，重新聚类后仍有效）
+    std::vector<int> roots_;          ///< 聚类树的根节点 ID 列表
     QList<QPointF> points_;           ///< 数据点坐标列表
     std::vector<int> labels_;         ///< 每个点对应的类别标签
     std::vector<double> colorBiases_; ///< 颜色偏移数组，用于不同聚类层级颜色区分
@@ -8,7 +8,7 @@
 #include "Label2Color.h"
 
 CoordinateWidget::CoordinateWidget(QWidget *parent)
-    : QWidget(parent), prob_window(nullptr), tree_window(nullptr){
+    : QWidget(parent), prob_window(nullptr), tree_window(nullptr), inertia_window(nullptr){
        
     QPalette palette = this->palette();
     palette.setColor(QPalette::Window, Qt::white);
@@ -100,8 +100,8 @@ void CoordinateWidget::setProbs(const std::vector<double>& probs) {
 }
 
 
-void CoordinateWidget::setRoots(const std::vector<ClusterNode*>& roots, int nClusters){
-    if (!roots.empty() && drawAuxi) {
+void CoordinateWidget::setRoots(const std::shared_ptr<const Dendrogram>& tree, const std::vector<int>& roots, int nClusters){
+    if (tree && !roots.empty() && drawAuxi) {
         if (points.isEmpty()) {
             std::cerr << "Points list is empty!" << std::endl;
             return;
@@ -115,7 +115,7 @@ void CoordinateWidget::setRoots(const std::vector<ClusterNode*>& roots, int nClu
                 tree_window = nullptr;
             });
         }
-        tree_window->setData(roots, points, labels, nClusters); 
+        tree_window->setData(tree, roots, points, labels, nClusters); 
         
     } else {
         if (tree_window) {
@@ -125,6 +125,28 @@ void CoordinateWidget::setRoots(const std::vector<ClusterNode*>& roots, int nClu
     }
 }
 
+void CoordinateWidget::setInertiaCurve(const std::vector<int>& ks, const std::vector<double>& costs, int elbow){
+    if (!ks.empty() && drawAuxi) {
+        if (!inertia_window) {
+            inertia_window = new SubWindowInertia(this);
+            inertia_window->resize(800, 600);
+            inertia_window->move(600, 100);
+            inertia_window->show();
+            // 连接 destroyed 信号，在窗口关闭时将指针置空
+            connect(inertia_window, &QObject::destroyed, this, [this]() {
+                inertia_window = nullptr;
+            });
+        }
+        inertia_window->setData(ks, costs, elbow);
+
+    } else {
+        if (inertia_window) {
+            delete inertia_window; // 会触发 destroyed 信号，自动置空
+            inertia_window = nullptr;
+        }
+    }
+}
+
 void CoordinateWidget::setFlags(bool flag){
     if(flag){
         drawAuxi = !drawAuxi;
@@ -11,9 +11,10 @@
 #include <vector>                   // 使用 std::vector 存储数据结构
 
 // 自定义头文件
-#include "clustering/Cluster.h"     // 聚类相关类（如 ClusterNode）
+#include "clustering/Cluster.h"     // 聚类相关类（如 Dendrogram）
 #include "ShowProbs.h"              // 显示概率窗口
 #include "ShowTree.h"               // 显示树状结构窗口
+#include "ShowInertia.h"            // 显示 K 扫描代价曲线窗口
 
 /**
  * @class CoordinateWidget
@@ -89,13 +90,22 @@ public slots:
 
     /**
      * 设置聚类树结构（如层次聚类）
-     * @param w_roots 聚类根节点指针列表
+     * @param w_tree 聚类树节点池（共享持有，重新聚类后旧树仍可安全绘制）
+     * @param w_roots 聚类根节点 ID 列表
      * @param nClusters 聚类数量
      */
-    void setRoots(const std::vector<ClusterNode*>& w_roots, int nClusters);
+    void setRoots(const std::shared_ptr<const Dendrogram>& w_tree, const std::vector<int>& w_roots, int nClusters);
 
     /**
-     * 控制是否启用辅助图形（如概率窗、树结构窗）
+     * 设置 K 扫描的代价曲线（K-Means 的 kMax 大于 k 时）
+     * @param ks 扫描的各个 K
+     * @param costs 每个 K 的代价
+     * @param elbow 肘部在序列中的下标
+     */
+    void setInertiaCurve(const std::vector<int>& ks, const std::vector<double>& costs, int elbow);
+
+    /**
+     * 控制是否启用辅助图形（如概率窗、树结构窗、代价曲线窗）
      * @param flag 开关标志
      */
     void setFlags(bool flag);
@@ -197,6 +207,7 @@ private:
 
     SubWindowProbs *prob_window;    ///< 概率展示子窗口
     SubWindowTree *tree_window;     ///< 树结构展示子窗口
+    SubWindowInertia *inertia_window; ///< K 扫描代价曲线子窗口
 
     bool drawAuxi = false;          ///< 是否绘制辅助信息（如概率窗口触发）
 
@@ -6,7 +6,7 @@ Q_DECLARE_METATYPE(std::vector<int>)
 Q_DECLARE_METATYPE(std::vector<std::vector<double>>)
 Q_DECLARE_METATYPE(std::vector<Pointtype>)
 Q_DECLARE_METATYPE(std::vector<double>)
-Q_DECLARE_METATYPE(std::vector<ClusterNode*>)
+Q_DECLARE_METATYPE(std::shared_ptr<const Dendrogram>)
 
 int main(int argc, char *argv[]) {
     QApplication app(argc, argv);
@@ -14,7 +14,7 @@ int main(int argc, char *argv[]) {
     qRegisterMetaType<std::vector<std::vector<double>>>("std::vector<std::vector<double>>");
     qRegisterMetaType<std::vector<Pointtype>>("std::vector<Pointtype>");
     qRegisterMetaType<std::vector<double>>("std::vector<double>");
-    qRegisterMetaType<std::vector<ClusterNode*>>("std::vector<ClusterNode*>");
+    qRegisterMetaType<std::shared_ptr<const Dendrogram>>("std::shared_ptr<const Dendrogram>");
     
     MainWindow window;
     window.show();
@@ -86,6 +86,8 @@ MainWindow::MainWindow(QWidget *parent)
     menu->addAction("DPMM");
     menu->addAction("Affinity_Propagation");
     menu->addAction("Spectral");
+    menu->addAction("OPTICS");
+    menu->addAction("HDBSCAN");
 
     clusterButton->setMenu(menu);
 
@@ -111,6 +113,27 @@ MainWindow::MainWindow(QWidget *parent)
     connect(scaleButton, &QPushButton::clicked, this, &MainWindow::onscaleButton_clicked);
     connect(coordinateWidget, &CoordinateWidget::pointsChanged, this, &MainWindow::handlePointsChanged);
 
+    linkageLineEdit = nullptr;
+    linkageButton = nullptr;
+    linkageMenu = nullptr;
+    engineLineEdit = nullptr;
+    engineButton = nullptr;
+    engineMenu = nullptr;
+    initLineEdit = nullptr;
+    initButton = nullptr;
+    initMenu = nullptr;
+    ninitValueLineEdit = nullptr;
+    kmaxValueLineEdit = nullptr;
+    floatcheckBox = nullptr;
+    incrementalcheckBox = nullptr;
+    lazycheckBox = nullptr;
+    maxepsValueLineEdit = nullptr;
+    rhoValueLineEdit = nullptr;
+    minclusterValueLineEdit = nullptr;
+    parallelcheckBox = nullptr;
+    batchValueLineEdit = nullptr;
+    historyStepLineEdit = nullptr;
+
     clustertype = None;
     isRunning = false;
     shouldStopAnimation = false;
@@ -175,6 +198,26 @@ void MainWindow::onClearClicked() {
     normLineEdit = nullptr;
     normButton = nullptr;
     normMenu = nullptr;
+    linkageLineEdit = nullptr;
+    linkageButton = nullptr;
+    linkageMenu = nullptr;
+    engineLineEdit = nullptr;
+    engineButton = nullptr;
+    engineMenu = nullptr;
+    initLineEdit = nullptr;
+    initButton = nullptr;
+    initMenu = nullptr;
+    ninitValueLineEdit = nullptr;
+    kmaxValueLineEdit = nullptr;
+    floatcheckBox = nullptr;
+    incrementalcheckBox = nullptr;
+    lazycheckBox = nullptr;
+    maxepsValueLineEdit = nullptr;
+    rhoValueLineEdit = nullptr;
+    minclusterValueLineEdit = nullptr;
+    parallelcheckBox = nullptr;
+    batchValueLineEdit = nullptr;
+    historyStepLineEdit = nullptr;
     sigmaValueLineEdit = nullptr;
     initcheckBox = nullptr;
     knnparamLineEdit = nullptr;
@@ -292,6 +335,26 @@ void MainWindow::handleClusterLoad(QAction *action) {
         delete normLineEdit;
         delete normButton;
         delete normMenu;
+        delete linkageLineEdit;
+        delete linkageButton;
+        delete linkageMenu;
+        delete engineLineEdit;
+        delete engineButton;
+        delete engineMenu;
+        delete initLineEdit;
+        delete initButton;
+        delete initMenu;
+        delete ninitValueLineEdit;
+        delete kmaxValueLineEdit;
+        delete floatcheckBox;
+        delete incrementalcheckBox;
+        delete lazycheckBox;
+        delete maxepsValueLineEdit;
+        delete rhoValueLineEdit;
+        delete minclusterValueLineEdit;
+        delete parallelcheckBox;
+        delete batchValueLineEdit;
+        delete historyStepLineEdit;
         delete sigmaValueLineEdit;
         delete initcheckBox;
         delete knnparamLineEdit;
@@ -307,6 +370,26 @@ void MainWindow::handleClusterLoad(QAction *action) {
         normLineEdit = nullptr;
         normButton = nullptr;
         normMenu = nullptr;
+        linkageLineEdit = nullptr;
+        linkageButton = nullptr;
+        linkageMenu = nullptr;
+        engineLineEdit = nullptr;
+        engineButton = nullptr;
+        engineMenu = nullptr;
+        initLineEdit = nullptr;
+        initButton = nullptr;
+        initMenu = nullptr;
+        ninitValueLineEdit = nullptr;
+        kmaxValueLineEdit = nullptr;
+        floatcheckBox = nullptr;
+        incrementalcheckBox = nullptr;
+        lazycheckBox = nullptr;
+        maxepsValueLineEdit = nullptr;
+        rhoValueLineEdit = nullptr;
+        minclusterValueLineEdit = nullptr;
+        parallelcheckBox = nullptr;
+        batchValueLineEdit = nullptr;
+        historyStepLineEdit = nullptr;
         sigmaValueLineEdit = nullptr;
         initcheckBox = nullptr;
         knnparamLineEdit = nullptr;
@@ -327,6 +410,78 @@ void MainWindow::handleClusterLoad(QAction *action) {
             tolValueLineEdit->setPlaceholderText("Enter tol value");
             tolValueLineEdit->setFixedSize(400, 50);
             tolValueLineEdit->setFont(lineEditFont);
+            engineLineEdit = new QLineEdit(this);
+            engineLineEdit->setText("Lloyd");
+            engineLineEdit->setReadOnly(true); // 设置为只读
+            engineLineEdit->setFixedSize(400, 50);
+            engineLineEdit->setFont(lineEditFont);
+
+            engineButton = new QToolButton(this);
+            engineButton->setText("Engine");
+            engineButton->setPopupMode(QToolButton::MenuButtonPopup);
+            engineButton->setFixedSize(100, 50);
+            engineButton->setFont(buttonFont);
+            engineMenu = new QMenu(this);
+            engineMenu->addAction("Lloyd");
+            engineMenu->addAction("Elkan");
+            engineMenu->addAction("Hamerly");
+            engineMenu->addAction("MiniBatch");
+            engineMenu->addAction("KdTree");
+            engineMenu->addAction("Bisecting");
+            engineButton->setMenu(engineMenu);
+            initLineEdit = new QLineEdit(this);
+            initLineEdit->setText("Random");
+            initLineEdit->setReadOnly(true); // 设置为只读
+            initLineEdit->setFixedSize(400, 50);
+            initLineEdit->setFont(lineEditFont);
+
+            initButton = new QToolButton(this);
+            initButton->setText("Init");
+            initButton->setPopupMode(QToolButton::MenuButtonPopup);
+            initButton->setFixedSize(100, 50);
+            initButton->setFont(buttonFont);
+            initMenu = new QMenu(this);
+            initMenu->addAction("Random");
+            initMenu->addAction("KMeans++");
+            initMenu->addAction("KMeans||");
+            initButton->setMenu(initMenu);
+            ninitValueLineEdit = new QLineEdit(this);
+            ninitValueLineEdit->setPlaceholderText("Enter n_init value");
+            ninitValueLineEdit->setFixedSize(400, 50);
+            ninitValueLineEdit->setFont(lineEditFont);
+            kmaxValueLineEdit = new QLineEdit(this);
+            kmaxValueLineEdit->setPlaceholderText("Enter K max (sweep K..Kmax)");
+            kmaxValueLineEdit->setFixedSize(400, 50);
+            kmaxValueLineEdit->setFont(lineEditFont);
+            floatcheckBox = new QCheckBox("Float Precision", this);
+            floatcheckBox->setChecked(false);
+            floatcheckBox->setStyleSheet(
+                "QCheckBox {"
+                "    font-size: 16px;"
+                "    padding: 10px;"
+                "    min-width: 120px;"
+                "    min-height: 30px;"
+                "}"
+            );
+            incrementalcheckBox = new QCheckBox("Incremental", this);
+            incrementalcheckBox->setChecked(false);
+            incrementalcheckBox->setStyleSheet(
+                "QCheckBox {"
+                "    font-size: 16px;"
+                "    padding: 10px;"
+                "    min-width: 120px;"
+                "    min-height: 30px;"
+                "}"
+            );
+            incrementalcheckBox->setToolTip("Warm start from the previous result (Hamerly engine only; other engines run cold)");
+            batchValueLineEdit = new QLineEdit(this);
+            batchValueLineEdit->setPlaceholderText("Enter batch size (MiniBatch)");
+            batchValueLineEdit->setFixedSize(400, 50);
+            batchValueLineEdit->setFont(lineEditFont);
+            historyStepLineEdit = new QLineEdit(this);
+            historyStepLineEdit->setPlaceholderText("Enter history step (MiniBatch / Bisecting)");
+            historyStepLineEdit->setFixedSize(400, 50);
+            historyStepLineEdit->setFont(lineEditFont);
             // 添加到布局中
 
             delete parameterLayout;
@@ -335,7 +490,20 @@ void MainWindow::handleClusterLoad(QAction *action) {
             parameterLayout->addWidget(kValueLineEdit);
             parameterLayout->addWidget(MaxiterValueLineEdit);
             parameterLayout->addWidget(tolValueLineEdit);
+            parameterLayout->addWidget(engineButton);
+            parameterLayout->addWidget(engineLineEdit);
+            parameterLayout->addWidget(initButton);
+            parameterLayout->addWidget(initLineEdit);
+            parameterLayout->addWidget(ninitValueLineEdit);
+            parameterLayout->addWidget(kmaxValueLineEdit);
+            parameterLayout->addWidget(floatcheckBox);
+            parameterLayout->addWidget(incrementalcheckBox);
+            parameterLayout->addWidget(batchValueLineEdit);
+            parameterLayout->addWidget(historyStepLineEdit);
             buttonLayout->addLayout(parameterLayout); // 将布局添加到主界面
+
+            connect(engineMenu, &QMenu::triggered, this, &MainWindow::handleEngineLoad);
+            connect(initMenu, &QMenu::triggered, this, &MainWindow::handleInitLoad);
         }
         if(selectedAlgorithm == "DBSCAN"){
             clustertype = dbscan;
@@ -348,12 +516,95 @@ void MainWindow::handleClusterLoad(QAction *action) {
             minptsValueLineEdit->setPlaceholderText("Enter minpts value");
             minptsValueLineEdit->setFixedSize(400, 50);
             minptsValueLineEdit->setFont(lineEditFont);
+            rhoValueLineEdit = new QLineEdit(this);
+            rhoValueLineEdit->setPlaceholderText("Enter rho for approximate mode (optional, not with Incremental)");
+            rhoValueLineEdit->setFixedSize(400, 50);
+            rhoValueLineEdit->setFont(lineEditFont);
+            lazycheckBox = new QCheckBox("Lazy Neighbors", this);
+            lazycheckBox->setChecked(false);
+            lazycheckBox->setStyleSheet(
+                "QCheckBox {"
+                "    font-size: 16px;"
+                "    padding: 10px;"
+                "    min-width: 120px;"
+                "    min-height: 30px;"
+                "}"
+            );
+            incrementalcheckBox = new QCheckBox("Incremental", this);
+            incrementalcheckBox->setChecked(false);
+            incrementalcheckBox->setStyleSheet(
+                "QCheckBox {"
+                "    font-size: 16px;"
+                "    padding: 10px;"
+                "    min-width: 120px;"
+                "    min-height: 30px;"
+                "}"
+            );
+            parallelcheckBox = new QCheckBox("Parallel (Union-Find)", this);
+            parallelcheckBox->setChecked(false);
+            parallelcheckBox->setStyleSheet(
+                "QCheckBox {"
+                "    font-size: 16px;"
+                "    padding: 10px;"
+                "    min-width: 120px;"
+                "    min-height: 30px;"
+                "}"
+            );
             // 添加到布局中
             delete parameterLayout;
             parameterLayout = new QVBoxLayout();
 
             parameterLayout->addWidget(epsValueLineEdit);
             parameterLayout->addWidget(minptsValueLineEdit);
+            parameterLayout->addWidget(rhoValueLineEdit);
+            parameterLayout->addWidget(lazycheckBox);
+            parameterLayout->addWidget(parallelcheckBox);
+            parameterLayout->addWidget(incrementalcheckBox);
+            buttonLayout->addLayout(parameterLayout); // 将布局添加到主界面
+        }
+        if(selectedAlgorithm == "OPTICS"){
+            clustertype = optics;
+
+            epsValueLineEdit = new QLineEdit(this);
+            epsValueLineEdit->setPlaceholderText("Enter eps value (re-labels live)");
+            epsValueLineEdit->setFixedSize(400, 50);
+            epsValueLineEdit->setFont(lineEditFont);
+            minptsValueLineEdit = new QLineEdit(this);
+            minptsValueLineEdit->setPlaceholderText("Enter minpts value");
+            minptsValueLineEdit->setFixedSize(400, 50);
+            minptsValueLineEdit->setFont(lineEditFont);
+            maxepsValueLineEdit = new QLineEdit(this);
+            maxepsValueLineEdit->setPlaceholderText("Enter max eps (default: eps)");
+            maxepsValueLineEdit->setFixedSize(400, 50);
+            maxepsValueLineEdit->setFont(lineEditFont);
+            // 添加到布局中
+            delete parameterLayout;
+            parameterLayout = new QVBoxLayout();
+
+            parameterLayout->addWidget(epsValueLineEdit);
+            parameterLayout->addWidget(minptsValueLineEdit);
+            parameterLayout->addWidget(maxepsValueLineEdit);
+            buttonLayout->addLayout(parameterLayout); // 将布局添加到主界面
+
+            connect(epsValueLineEdit, &QLineEdit::textChanged, this, &MainWindow::handleEpsChanged);
+        }
+        if(selectedAlgorithm == "HDBSCAN"){
+            clustertype = hdbscan;
+
+            minptsValueLineEdit = new QLineEdit(this);
+            minptsValueLineEdit->setPlaceholderText("Enter minpts value");
+            minptsValueLineEdit->setFixedSize(400, 50);
+            minptsValueLineEdit->setFont(lineEditFont);
+            minclusterValueLineEdit = new QLineEdit(this);
+            minclusterValueLineEdit->setPlaceholderText("Enter min cluster size (default: minpts)");
+            minclusterValueLineEdit->setFixedSize(400, 50);
+            minclusterValueLineEdit->setFont(lineEditFont);
+            // 添加到布局中
+            delete parameterLayout;
+            parameterLayout = new QVBoxLayout();
+
+            parameterLayout->addWidget(minptsValueLineEdit);
+            parameterLayout->addWidget(minclusterValueLineEdit);
             buttonLayout->addLayout(parameterLayout); // 将布局添加到主界面
         }
         if(selectedAlgorithm == "Agglomerative"){
@@ -363,12 +614,64 @@ void MainWindow::handleClusterLoad(QAction *action) {
             nClustersValueLineEdit->setPlaceholderText("Enter nClusters value");
             nClustersValueLineEdit->setFixedSize(400, 50);
             nClustersValueLineEdit->setFont(lineEditFont);
+            linkageLineEdit = new QLineEdit(this);
+            linkageLineEdit->setText("Average");
+            linkageLineEdit->setReadOnly(true); // 设置为只读
+            linkageLineEdit->setFixedSize(400, 50);
+            linkageLineEdit->setFont(lineEditFont);
+
+            linkageButton = new QToolButton(this);
+            linkageButton->setText("Linkage");
+            linkageButton->setPopupMode(QToolButton::MenuButtonPopup);
+            linkageButton->setFixedSize(100, 50);
+            linkageButton->setFont(buttonFont);
+            linkageMenu = new QMenu(this);
+            linkageMenu->addAction("Average");
+            linkageMenu->addAction("Complete");
+            linkageMenu->addAction("Single");
+            linkageMenu->addAction("Ward");
+            linkageButton->setMenu(linkageMenu);
+            engineLineEdit = new QLineEdit(this);
+            engineLineEdit->setText("NNChain");
+            engineLineEdit->setReadOnly(true); // 设置为只读
+            engineLineEdit->setFixedSize(400, 50);
+            engineLineEdit->setFont(lineEditFont);
+
+            engineButton = new QToolButton(this);
+            engineButton->setText("Engine");
+            engineButton->setPopupMode(QToolButton::MenuButtonPopup);
+            engineButton->setFixedSize(100, 50);
+            engineButton->setFont(buttonFont);
+            engineMenu = new QMenu(this);
+            engineMenu->addAction("NNChain");
+            engineMenu->addAction("PairQueue");
+            engineButton->setMenu(engineMenu);
+            floatcheckBox = new QCheckBox("Float Precision", this);
+            floatcheckBox->setChecked(false);
+            floatcheckBox->setToolTip("Store distances as float (NNChain engine only; PairQueue always accumulates in double)");
+            floatcheckBox->setStyleSheet(
+                "QCheckBox {"
+                "    font-size: 16px;"
+                "    padding: 10px;"
+                "    min-width: 120px;"
+                "    min-height: 30px;"
+                "}"
+            );
             // 添加到布局中
             delete parameterLayout;
             parameterLayout = new QVBoxLayout();
 
             parameterLayout->addWidget(nClustersValueLineEdit);
+            parameterLayout->addWidget(linkageButton);
+            parameterLayout->addWidget(linkageLineEdit);
+            parameterLayout->addWidget(engineButton);
+            parameterLayout->addWidget(engineLineEdit);
+            parameterLayout->addWidget(floatcheckBox);
             buttonLayout->addLayout(parameterLayout); // 将布局添加到主界面
+
+            connect(linkageMenu, &QMenu::triggered, this, &MainWindow::handleLinkageLoad);
+            connect(nClustersValueLineEdit, &QLineEdit::textChanged, this, &MainWindow::handleNClustersChanged);
+            connect(engineMenu, &QMenu::triggered, this, &MainWindow::handleEngineLoad);
         }
         if(selectedAlgorithm == "DPMM"){
             clustertype = dpmm;
@@ -438,6 +741,16 @@ void MainWindow::handleClusterLoad(QAction *action) {
             MaxiterValueLineEdit->setPlaceholderText("Enter maxiter value");
             MaxiterValueLineEdit->setFixedSize(400, 50);
             MaxiterValueLineEdit->setFont(lineEditFont);
+            floatcheckBox = new QCheckBox("Float Precision", this);
+            floatcheckBox->setChecked(false);
+            floatcheckBox->setStyleSheet(
+                "QCheckBox {"
+                "    font-size: 16px;"
+                "    padding: 10px;"
+                "    min-width: 120px;"
+                "    min-height: 30px;"
+                "}"
+            );
             // 添加到布局中
             delete parameterLayout;
             parameterLayout = new QVBoxLayout();
@@ -446,6 +759,7 @@ void MainWindow::handleClusterLoad(QAction *action) {
             parameterLayout->addWidget(preferenceValueLineEdit);
             parameterLayout->addWidget(tolValueLineEdit);
             parameterLayout->addWidget(MaxiterValueLineEdit);
+            parameterLayout->addWidget(floatcheckBox);
             buttonLayout->addLayout(parameterLayout); // 将布局添加到主界面
         }
         if(selectedAlgorithm == "Spectral"){
@@ -475,6 +789,16 @@ void MainWindow::handleClusterLoad(QAction *action) {
             normMenu->addAction("RW");
             normMenu->addAction("SYM");
             normButton->setMenu(normMenu);
+            floatcheckBox = new QCheckBox("Float Precision", this);
+            floatcheckBox->setChecked(false);
+            floatcheckBox->setStyleSheet(
+                "QCheckBox {"
+                "    font-size: 16px;"
+                "    padding: 10px;"
+                "    min-width: 120px;"
+                "    min-height: 30px;"
+                "}"
+            );
             // 添加到布局中
             delete parameterLayout;
             parameterLayout = new QVBoxLayout();
@@ -483,6 +807,7 @@ void MainWindow::handleClusterLoad(QAction *action) {
             parameterLayout->addWidget(sigmaValueLineEdit);
             parameterLayout->addWidget(normButton);
             parameterLayout->addWidget(normLineEdit);
+            parameterLayout->addWidget(floatcheckBox);
             buttonLayout->addLayout(parameterLayout); // 将布局添加到主界面
 
             connect(normMenu, &QMenu::triggered, this, &MainWindow::handleNormLoad);
@@ -529,6 +854,54 @@ void MainWindow::handleNormLoad(QAction *action){
     normLineEdit->setText(selectedNorm); // 更新文本框内容
 }
 
+void MainWindow::handleLinkageLoad(QAction *action){
+    QString selectedLinkage = action->text();
+    linkageLineEdit->setText(selectedLinkage); // 更新文本框内容
+}
+
+void MainWindow::handleEngineLoad(QAction *action){
+    QString selectedEngine = action->text();
+    engineLineEdit->setText(selectedEngine); // 更新文本框内容
+}
+
+void MainWindow::handleInitLoad(QAction *action){
+    QString selectedInit = action->text();
+    initLineEdit->setText(selectedInit); // 更新文本框内容
+}
+
+bool MainWindow::resultMatchesPoints() const {
+    if (!onecluster || onecluster->X.rows() != localPoints.size() || onecluster->X.cols() != 2) return false;
+    for (int i = 0; i < localPoints.size(); ++i) {
+        if (onecluster->X(i, 0) != localPoints[i].x() || onecluster->X(i, 1) != localPoints[i].y()) return false;
+    }
+    return true;
+}
+
+void MainWindow::handleEpsChanged(const QString &text){
+    bool ok = false;
+    double eps = text.toDouble(&ok);
+    if (!ok || eps <= 0 || clustertype != optics || !resultMatchesPoints()) return; // 点集已变化，需要重新 Apply
+
+    if (onecluster->relabel(eps)) {
+        param.eps = eps;
+        coordinateWidget->setLabels(onecluster->labels);
+        coordinateWidget->setPoint_features(onecluster->point_features, eps);
+        qDebug() << "OPTICS re-labelled with eps:" << eps;
+    }
+}
+
+void MainWindow::handleNClustersChanged(const QString &text){
+    bool ok = false;
+    int k = text.toInt(&ok);
+    if (!ok || clustertype != agglomerative || !resultMatchesPoints()) return; // 点集已变化，需要重新 Apply
+
+    if (onecluster->recut(k)) {
+        param.nClusters = k;
+        coordinateWidget->setLabels(onecluster->labels);
+        qDebug() << "Agglomerative re-cut at nClusters:" << k;
+    }
+}
+
 void MainWindow::applyButtonClicked() {
     qDebug() << "=== Clustering Parameters ===";
     bool ok = true;
@@ -565,6 +938,45 @@ void MainWindow::applyButtonClicked() {
         ok = ok && right;
     }
     
+    // OPTICS 生成半径
+    if (maxepsValueLineEdit && !maxepsValueLineEdit->text().isEmpty()) {
+        param.maxEps = maxepsValueLineEdit->text().toDouble(&right);
+        if(param.maxEps <= 0) right = false;
+        if (right) qDebug() << "Max EPS Value:" << param.maxEps;
+        else qDebug() << "Invalid Max EPS value";
+        ok = ok && right;
+    }else{
+        param.maxEps = 0;
+    }
+
+    // HDBSCAN* 最小簇大小
+    if (minclusterValueLineEdit && !minclusterValueLineEdit->text().isEmpty()) {
+        param.minClusterSize = minclusterValueLineEdit->text().toInt(&right);
+        if(param.minClusterSize < 2) right = false;
+        if (right) qDebug() << "Min Cluster Size:" << param.minClusterSize;
+        else qDebug() << "Invalid Min Cluster Size value";
+        ok = ok && right;
+    }else{
+        param.minClusterSize = 0;
+    }
+
+    // ρ-近似 DBSCAN
+    if (rhoValueLineEdit && !rhoValueLineEdit->text().isEmpty()) {
+        param.rho = rhoValueLineEdit->text().toDouble(&right);
+        if(param.rho <= 0) right = false;
+        if (right) qDebug() << "Rho Value:" << param.rho;
+        else qDebug() << "Invalid Rho value";
+        ok = ok && right;
+    }else{
+        param.rho = 0;
+    }
+
+    // DBSCAN 只计数模式
+    param.lazyNeighbors = lazycheckBox && lazycheckBox->isChecked();
+
+    // DBSCAN 并行引擎
+    param.parallelDBSCAN = parallelcheckBox && parallelcheckBox->isChecked();
+
     // Agglomerative 参数
     if (nClustersValueLineEdit && !nClustersValueLineEdit->text().isEmpty()) {
         param.nClusters = nClustersValueLineEdit->text().toInt(&right);
@@ -631,6 +1043,8 @@ void MainWindow::applyButtonClicked() {
         if (right) qDebug() << "Sigma Value:" << param.sigma;
         else qDebug() << "Invalid Sigma value";
         ok = ok && right;
+    } else{
+        param.sigma = 1.0;
     }
     
     // Norm 类型
@@ -644,6 +1058,113 @@ void MainWindow::applyButtonClicked() {
         param.normType = NoNorm;
     }
 
+    // 层次聚类链接方式
+    if (linkageLineEdit && !linkageLineEdit->text().isEmpty()) {
+        QString text = linkageLineEdit->text();
+        if (text == "Average") param.linkage = AverageLinkage;
+        else if (text == "Complete") param.linkage = CompleteLinkage;
+        else if (text == "Single") param.linkage = SingleLinkage;
+        else if (text == "Ward") param.linkage = WardLinkage;
+        qDebug() << "Linkage:" << text;
+    }else{
+        param.linkage = AverageLinkage;
+    }
+
+    // 层次聚类合并引擎（与 K-Means 共用引擎选择控件）
+    if (clustertype == agglomerative && engineLineEdit && !engineLineEdit->text().isEmpty()) {
+        QString text = engineLineEdit->text();
+        if (text == "NNChain") param.aggloEngine = NNChainEngine;
+        else if (text == "PairQueue") param.aggloEngine = PairQueueEngine;
+        qDebug() << "Agglomerative Engine:" << text;
+    }else{
+        param.aggloEngine = NNChainEngine;
+    }
+
+    // K-Means 迭代引擎
+    if (clustertype == k_means && engineLineEdit && !engineLineEdit->text().isEmpty()) {
+        QString text = engineLineEdit->text();
+        if (text == "Lloyd") param.kmeansEngine = LloydEngine;
+        else if (text == "Elkan") param.kmeansEngine = ElkanEngine;
+        else if (text == "Hamerly") param.kmeansEngine = HamerlyEngine;
+        else if (text == "MiniBatch") param.kmeansEngine = MiniBatchEngine;
+        else if (text == "KdTree") param.kmeansEngine = KdTreeEngine;
+        else if (text == "Bisecting") param.kmeansEngine = BisectingEngine;
+        qDebug() << "KMeans Engine:" << text;
+    }else{
+        param.kmeansEngine = LloydEngine;
+    }
+
+    // K-Means 初始化方式
+    if (initLineEdit && !initLineEdit->text().isEmpty()) {
+        QString text = initLineEdit->text();
+        if (text == "Random") param.kmeansInit = RandomInit;
+        else if (text == "KMeans++") param.kmeansInit = PlusPlusInit;
+        else if (text == "KMeans||") param.kmeansInit = ParallelInit;
+        qDebug() << "KMeans Init:" << text;
+    }else{
+        param.kmeansInit = RandomInit;
+    }
+
+    if (ninitValueLineEdit && !ninitValueLineEdit->text().isEmpty()) {
+        param.n_init = ninitValueLineEdit->text().toInt(&right);
+        if(param.n_init <= 0) right = false;
+        if (right) qDebug() << "n_init Value:" << param.n_init;
+        else qDebug() << "Invalid n_init value";
+        ok = ok && right;
+    }else{
+        param.n_init = 1;
+    }
+
+    // K-Means K 扫描上界（不填或不大于 K 时不扫描）
+    if (kmaxValueLineEdit && !kmaxValueLineEdit->text().isEmpty()) {
+        param.kMax = kmaxValueLineEdit->text().toInt(&right);
+        if(param.kMax <= 0 || param.kMax > localPoints.size()) right = false;
+        if (right) qDebug() << "K max Value:" << param.kMax;
+        else qDebug() << "Invalid K max value";
+        ok = ok && right;
+    }else{
+        param.kMax = 0;
+    }
+
+    // 存储精度（K-Means 的数据与中心；层次聚类、AP、谱聚类的距离矩阵）
+    param.useFloat = floatcheckBox && floatcheckBox->isChecked();
+
+    // 增量模式（K-Means 从上一次的中心热启动，DBSCAN 只增删编辑过的点）
+    param.incremental = incrementalcheckBox && incrementalcheckBox->isChecked();
+    // 增量 DBSCAN 维护的是精确的邻域计数，不能与 ρ-近似同时使用
+    if (param.incremental && param.rho > 0) {
+        qDebug() << "Invalid Rho value: approximate mode cannot be combined with Incremental";
+        ok = false;
+    }
+    if (param.incremental && clustertype == k_means && param.kmeansEngine != HamerlyEngine) {
+        qDebug() << "Incremental warm start requires the Hamerly engine, running a cold start instead";
+    }
+
+    // Mini-batch 参数
+    if (batchValueLineEdit && !batchValueLineEdit->text().isEmpty()) {
+        param.batchSize = batchValueLineEdit->text().toInt(&right);
+        if(param.batchSize <= 0) right = false;
+        if (right) qDebug() << "Batch Size:" << param.batchSize;
+        else qDebug() << "Invalid Batch Size";
+        ok = ok && right;
+    }else{
+        param.batchSize = 1024;
+    }
+
+    // 默认记录步长：二分 K-Means 每次分裂一帧（分裂次数只有 K - 1），Mini-batch 每 10 批一帧
+    int defaultHistoryStep = param.kmeansEngine == BisectingEngine ? 1 : 10;
+    if (historyStepLineEdit && !historyStepLineEdit->text().isEmpty()) {
+        bool inside_right;
+        param.historyStep = historyStepLineEdit->text().toInt(&inside_right);
+        if (inside_right && param.historyStep > 0) qDebug() << "History Step:" << param.historyStep;
+        else {
+            param.historyStep = defaultHistoryStep;
+            qDebug() << "Invalid History Step, use" << defaultHistoryStep;
+        }
+    }else{
+        param.historyStep = defaultHistoryStep;
+    }
+
     if (knnparamLineEdit && !knnparamLineEdit->text().isEmpty()){
         param.n_neighbors = knnparamLineEdit->text().toInt(&right);
         if(param.n_neighbors <= 0) right = false;
@@ -662,6 +1183,12 @@ void MainWindow::applyButtonClicked() {
             onecluster->setParams(param);
             onecluster->start();  
             coordinateWidget->setLabels(onecluster->labels);
+            for (size_t i = 0; i < onecluster->inertia_curve.size(); ++i) {
+                qDebug() << "K =" << onecluster->sweep_ks[i] << "inertia =" << onecluster->inertia_curve[i];
+            }
+            if (!onecluster->inertia_curve.empty()) {
+                qDebug() << "Elbow K:" << onecluster->sweep_ks[onecluster->sweep_elbow];
+            }
         }
     }
     waitingLabel->hide();
@@ -675,7 +1202,13 @@ void MainWindow::auxButtonClicked() {
         coordinateWidget->setCenters(onecluster->centers);
         coordinateWidget->setPoint_features(onecluster->point_features, param.eps);
         coordinateWidget->setProbs(onecluster->probs);
-        coordinateWidget->setRoots(onecluster->roots, param.nClusters);
+        // HDBSCAN* 的簇数由选簇结果决定
+        int nClusters = param.nClusters;
+        if (onecluster->params.clustertype == hdbscan) {
+            nClusters = onecluster->labels.empty() ? 0 : *std::max_element(onecluster->labels.begin(), onecluster->labels.end()) + 1;
+        }
+        coordinateWidget->setRoots(onecluster->tree, onecluster->roots, nClusters);
+        coordinateWidget->setInertiaCurve(onecluster->sweep_ks, onecluster->inertia_curve, onecluster->sweep_elbow);
     } else {
         // 可选：处理 onecluster 不存在的情况，比如提示用户加载数据
         qDebug() << "Error: onecluster is null. Please load cluster data first.";
@@ -691,31 +1224,32 @@ void MainWindow::displayButtonClicked() {
 
         QThreadPool::globalInstance()->start([this]() {
             if (onecluster){
-                for (int i = 0; i < onecluster->label_history.size(); ++i) {
+                for (int i = 0; i < onecluster->historySize(); ++i) {
                     if (isWindowClosing.load()) break;
                     if (shouldStopAnimation.load()) break;
                     if (!coordinateWidget) continue;
                     
 
                     QMetaObject::invokeMethod(coordinateWidget, "setLabels", Qt::QueuedConnection,
-                                            Q_ARG(std::vector<int>, onecluster->label_history[i]));
+                                            Q_ARG(std::vector<int>, onecluster->labelFrame(i)));
 
-                    if (onecluster->center_history.size() == onecluster->label_history.size()) {
+                    if (onecluster->center_history.size() == onecluster->historySize()) {
                         QMetaObject::invokeMethod(coordinateWidget, "setCenters", Qt::QueuedConnection,
                                                 Q_ARG(std::vector<std::vector<double>>, onecluster->center_history[i]));
                     }
-                    if (onecluster->point_feature_history.size() == onecluster->label_history.size()) {
+                    if (onecluster->pointFeatureHistorySize() == onecluster->historySize()) {
                         QMetaObject::invokeMethod(coordinateWidget, "setPoint_features", Qt::QueuedConnection,
-                                                Q_ARG(std::vector<Pointtype>, onecluster->point_feature_history[i]),
+                                                Q_ARG(std::vector<Pointtype>, onecluster->pointFeatureFrame(i)),
                                                 Q_ARG(double, param.eps));
                     }
-                    if (onecluster->prob_history.size() == onecluster->label_history.size()) {
+                    if (onecluster->prob_history.size() == onecluster->historySize()) {
                         QMetaObject::invokeMethod(coordinateWidget, "setProbs", Qt::QueuedConnection,
                                                 Q_ARG(std::vector<double>, onecluster->prob_history[i]));
                     }
-                    if (onecluster->root_history.size() == onecluster->label_history.size() && onecluster->num_history.size() == onecluster->label_history.size()) {
+                    if (onecluster->rootHistorySize() == onecluster->historySize() && onecluster->num_history.size() == onecluster->historySize()) {
                         QMetaObject::invokeMethod(coordinateWidget, "setRoots", Qt::QueuedConnection,
-                                                Q_ARG(std::vector<ClusterNode*>, onecluster->root_history[i]),
+                                                Q_ARG(std::shared_ptr<const Dendrogram>, onecluster->tree),
+                                                Q_ARG(std::vector<int>, onecluster->rootFrame(i)),
                                                 Q_ARG(int, onecluster->num_history[i]));
                     }
                     QThread::msleep(animationDelay.load());
@@ -89,7 +89,44 @@ private slots:
      */
     void handleNormLoad(QAction *action);
 
+    /**
+     * 处理选择层次聚类链接方式菜单项的点击事件
+     * @param action 被点击的 QAction 对象
+     */
+    void handleLinkageLoad(QAction *action);
+
+    /**
+     * 处理选择迭代引擎菜单项的点击事件（K-Means 与层次聚类共用）
+     * @param action 被点击的 QAction 对象
+     */
+    void handleEngineLoad(QAction *action);
+
+    /**
+     * 处理选择 K-Means 初始化方式菜单项的点击事件
+     * @param action 被点击的 QAction 对象
+     */
+    void handleInitLoad(QAction *action);
+
+    /**
+     * eps 输入框内容变化时，若当前结果为 OPTICS 则直接按新的 eps 重新提取标签
+     * @param text eps 输入框的新内容
+     */
+    void handleEpsChanged(const QString &text);
+
+    /**
+     * nClusters 输入框内容变化时，若当前结果为层次聚类则直接在已有合并树上按新的簇数切分
+     * @param text nClusters 输入框的新内容
+     */
+    void handleNClustersChanged(const QString &text);
+
 private:
+    /**
+     * 当前结果是否仍对应画布上的点集（坐标逐一相同）；
+     * 加载了点数相同的新数据集后，已缓存的模型不能再用于重新提取标签
+     * @return 点集未变化时返回 true
+     */
+    bool resultMatchesPoints() const;
+
     // ========== UI 控件声明 ==========
 
     CoordinateWidget *coordinateWidget; ///< 自定义绘图组件，用于显示点集和聚类结果
@@ -126,6 +163,9 @@ private:
     QLineEdit* kValueLineEdit;          ///< KMeans 中的 K 值输入框
     QLineEdit* epsValueLineEdit;        ///< DBSCAN 中的 eps 值输入框
     QLineEdit* minptsValueLineEdit;     ///< DBSCAN 中的 minPts 值输入框
+    QLineEdit* maxepsValueLineEdit;     ///< OPTICS 中的生成半径输入框
+    QLineEdit* rhoValueLineEdit;        ///< ρ-近似 DBSCAN 中的近似参数输入框
+    QLineEdit* minclusterValueLineEdit; ///< HDBSCAN* 中的最小簇大小输入框
     QLineEdit* nClustersValueLineEdit;  ///< 层次聚类中的目标聚类数输入框
     QLineEdit* alphaValueLineEdit;      ///< MeanShift 中的 alpha 值输入框
     QLineEdit* dampingValueLineEdit;    ///< Affinity Propagation 中的 damping 值输入框
@@ -135,6 +175,23 @@ private:
     QLineEdit* normLineEdit;            ///< 显示当前选择的归一化方法
     QToolButton *normButton;            ///< 归一化方法选择按钮（带菜单）
     QMenu* normMenu;                    ///< 归一化方法菜单
+    QLineEdit* linkageLineEdit;         ///< 显示当前选择的层次聚类链接方式
+    QToolButton *linkageButton;         ///< 层次聚类链接方式选择按钮（带菜单）
+    QMenu* linkageMenu;                 ///< 层次聚类链接方式菜单
+    QLineEdit* engineLineEdit;          ///< 显示当前选择的迭代引擎（K-Means / 层次聚类）
+    QToolButton *engineButton;          ///< 迭代引擎选择按钮（带菜单）
+    QMenu* engineMenu;                  ///< 迭代引擎菜单
+    QLineEdit* initLineEdit;            ///< 显示当前选择的 K-Means 初始化方式
+    QToolButton *initButton;            ///< K-Means 初始化方式选择按钮（带菜单）
+    QMenu* initMenu;                    ///< K-Means 初始化方式菜单
+    QLineEdit* ninitValueLineEdit;      ///< K-Means 重启次数 n_init 输入框
+    QLineEdit* kmaxValueLineEdit;       ///< K-Means K 扫描上界输入框
+    QCheckBox* floatcheckBox;           ///< 是否使用 float 精度的复选框（K-Means、层次聚类、AP、谱聚类）
+    QCheckBox* incrementalcheckBox;     ///< K-Means 是否在点集编辑后增量热启动的复选框
+    QCheckBox* lazycheckBox;            ///< DBSCAN 是否使用只计数（按需查询邻居）模式的复选框
+    QCheckBox* parallelcheckBox;        ///< DBSCAN 是否使用并行（并查集）引擎的复选框
+    QLineEdit* batchValueLineEdit;      ///< Mini-batch K-Means 每批样本数输入框
+    QLineEdit* historyStepLineEdit;     ///< Mini-batch K-Means 历史记录间隔输入框
     QCheckBox* initcheckBox;            ///< 是否使用初始中心的复选框
     QLineEdit* knnparamLineEdit;        ///< KNN 参数输入框
     QLineEdit* sigmaValueLineEdit;      ///< 高斯核参数 sigma 输入框